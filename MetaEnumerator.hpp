@@ -2,17 +2,377 @@
 #define ELIGT_METAENUMERATOR_H
 
 #include <stddef.h>
-#include <sstream> 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 #include <climits>
+#include <cstdint>
+#include <cstdio>
 #include <limits>
 
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	#define METAENUMERATOR_STRING_VIEW 1
+	#include <string_view>
+#endif
+
+// Detect whether we can tell constant evaluation apart from run-time evaluation, which is required
+// to dispatch constexpr operations to non-constexpr intrinsics
+#if defined(__clang__)
+	#if defined(__has_builtin)
+		#if __has_builtin(__builtin_is_constant_evaluated)
+			#define METAENUMERATOR_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+		#endif
+	#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+	#define METAENUMERATOR_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+	#define METAENUMERATOR_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+// SIMD code paths are picked at compile time from the target ISA, define METAENUMERATOR_DISABLE_SIMD to always use the scalar fallback
+#if defined(METAENUMERATOR_CONSTANT_EVALUATED) && !defined(METAENUMERATOR_DISABLE_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define METAENUMERATOR_SIMD 1
+		#define METAENUMERATOR_SSE2 1
+		#if defined(__AVX2__)
+			#define METAENUMERATOR_AVX2 1
+		#endif
+		#if defined(__AVX512F__)
+			#define METAENUMERATOR_AVX512 1
+		#endif
+		#include <immintrin.h>
+	#endif
+	#if defined(__BMI2__)
+		#define METAENUMERATOR_BMI2 1
+		#include <immintrin.h>
+	#endif
+#endif
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64)
+	#define METAENUMERATOR_LITTLE_ENDIAN 1
+#endif
+
+// Masks between 65 and 128 bits use the native 128-bit integer when the compiler provides one, define METAENUMERATOR_DISABLE_INT128 to opt out
+#if defined(__SIZEOF_INT128__) && !defined(METAENUMERATOR_DISABLE_INT128)
+	#define METAENUMERATOR_INT128 1
+#endif
+
+// Files are memory mapped on POSIX systems, read into memory otherwise
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(METAENUMERATOR_DISABLE_MMAP)
+	#define METAENUMERATOR_MMAP 1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
 
 #ifdef METAENUMERATOR_NAMESPACE
 namespace METAENUMERATOR_NAMESPACE
 {
 #endif
 
+#if defined(METAENUMERATOR_INT128)
+__extension__ typedef unsigned __int128 EnumeratorUInt128;
+#endif
+
+// Bit manipulation helpers for unsigned integers of up to 64 bits, the behavior is undefined if value is 0 for count_trailing_zeros and count_leading_zeros
+struct EnumeratorBits
+{
+	static constexpr const size_t WIDE_BITS = std::numeric_limits<unsigned long long>::digits;
+	
+	template <typename T>
+	static inline constexpr size_t count_trailing_zeros(T value)
+	{
+		static_assert(sizeof(T) <= sizeof(unsigned long long), "EnumeratorBits: T must fit inside unsigned long long");
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_t>(__builtin_ctzll(static_cast<unsigned long long>(value)));
+#else
+		size_t count = 0;
+		auto wide = static_cast<unsigned long long>(value);
+		
+		for (size_t width = WIDE_BITS / 2; width > 0; width /= 2)
+		{
+			if ((wide & ((1ULL << width) - 1)) == 0)
+			{
+				wide >>= width;
+				count += width;
+			}
+		}
+		
+		return count;
+#endif
+	}
+	
+	template <typename T>
+	static inline constexpr size_t count_leading_zeros(T value)
+	{
+		static_assert(sizeof(T) <= sizeof(unsigned long long), "EnumeratorBits: T must fit inside unsigned long long");
+		constexpr const size_t padding = WIDE_BITS - std::numeric_limits<T>::digits;
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_t>(__builtin_clzll(static_cast<unsigned long long>(value))) - padding;
+#else
+		size_t count = 0;
+		auto wide = static_cast<unsigned long long>(value);
+		
+		for (size_t width = WIDE_BITS / 2; width > 0; width /= 2)
+		{
+			if ((wide >> (WIDE_BITS - width)) == 0)
+			{
+				wide <<= width;
+				count += width;
+			}
+		}
+		
+		return count - padding;
+#endif
+	}
+	
+	template <typename T>
+	static inline constexpr size_t popcount(T value)
+	{
+		static_assert(sizeof(T) <= sizeof(unsigned long long), "EnumeratorBits: T must fit inside unsigned long long");
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_t>(__builtin_popcountll(static_cast<unsigned long long>(value)));
+#else
+		auto wide = static_cast<unsigned long long>(value);
+		wide = wide - ((wide >> 1) & 0x5555555555555555ULL);
+		wide = (wide & 0x3333333333333333ULL) + ((wide >> 2) & 0x3333333333333333ULL);
+		wide = (wide + (wide >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<size_t>((wide * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+	
+	// Returns the position of the rank-th (0-based) set bit, the behavior is undefined if value has rank set bits or less
+	template <typename T>
+	static inline constexpr size_t select(T value, size_t rank)
+	{
+		static_assert(sizeof(T) <= sizeof(unsigned long long), "EnumeratorBits: T must fit inside unsigned long long");
+#if defined(METAENUMERATOR_BMI2)
+		if (!METAENUMERATOR_CONSTANT_EVALUATED())
+			return count_trailing_zeros(_pdep_u64(1ULL << rank, static_cast<unsigned long long>(value)));
+#endif
+		
+		// Binary search on the population count of each half
+		size_t position = 0;
+		auto wide = static_cast<unsigned long long>(value);
+		
+		for (size_t width = WIDE_BITS / 2; width > 0; width /= 2)
+		{
+			const size_t low = popcount(wide & ((1ULL << width) - 1));
+			
+			if (rank >= low)
+			{
+				rank -= low;
+				wide >>= width;
+				position += width;
+			}
+		}
+		
+		return position;
+	}
+};
+
+struct EnumeratorBitAnd
+{
+	template <typename T>
+	static inline constexpr T apply(T a, T b) { return a & b; }
+#if defined(METAENUMERATOR_SSE2)
+	static inline __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+#if defined(METAENUMERATOR_AVX2)
+	static inline __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+#if defined(METAENUMERATOR_AVX512)
+	static inline __m512i apply(__m512i a, __m512i b) { return _mm512_and_si512(a, b); }
+#endif
+};
+
+struct EnumeratorBitOr
+{
+	template <typename T>
+	static inline constexpr T apply(T a, T b) { return a | b; }
+#if defined(METAENUMERATOR_SSE2)
+	static inline __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+#if defined(METAENUMERATOR_AVX2)
+	static inline __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+#if defined(METAENUMERATOR_AVX512)
+	static inline __m512i apply(__m512i a, __m512i b) { return _mm512_or_si512(a, b); }
+#endif
+};
+
+struct EnumeratorBitXor
+{
+	template <typename T>
+	static inline constexpr T apply(T a, T b) { return a ^ b; }
+#if defined(METAENUMERATOR_SSE2)
+	static inline __m128i apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+#if defined(METAENUMERATOR_AVX2)
+	static inline __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif
+#if defined(METAENUMERATOR_AVX512)
+	static inline __m512i apply(__m512i a, __m512i b) { return _mm512_xor_si512(a, b); }
+#endif
+};
+
+// Unary operation, the second operand is ignored
+struct EnumeratorBitNot
+{
+	template <typename T>
+	static inline constexpr T apply(T a, T) { return ~a; }
+#if defined(METAENUMERATOR_SSE2)
+	static inline __m128i apply(__m128i a, __m128i) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+#endif
+#if defined(METAENUMERATOR_AVX2)
+	static inline __m256i apply(__m256i a, __m256i) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+#endif
+#if defined(METAENUMERATOR_AVX512)
+	static inline __m512i apply(__m512i a, __m512i) { return _mm512_xor_si512(a, _mm512_set1_epi32(-1)); }
+#endif
+};
+
+template <typename OperandType, size_t OperandCount>
+class EnumeratorDataKernel
+{
+public:
+	static constexpr const size_t BYTE_COUNT = sizeof(OperandType) * OperandCount;
+	// Index of the first operand not covered by the vector loops, which always end with 16 bytes wide SSE2 steps
+	static constexpr const size_t VECTOR_TAIL = (BYTE_COUNT / 16) * 16 / sizeof(OperandType);
+	
+	// Computes result[i] = Operation(a[i], b[i]) for every operand, result may alias a or b
+	template <typename Operation>
+	static inline constexpr void transform(OperandType* result, const OperandType* a, const OperandType* b)
+	{
+#if defined(METAENUMERATOR_SIMD)
+		if (!METAENUMERATOR_CONSTANT_EVALUATED())
+			return transform_vector<Operation>(result, a, b);
+#endif
+		
+		transform_scalar<Operation>(result, a, b);
+	}
+	
+	// Returns true if any bit of Operation(a[i], b[i]) is set for any operand
+	template <typename Operation>
+	static inline constexpr bool any(const OperandType* a, const OperandType* b)
+	{
+#if defined(METAENUMERATOR_SIMD)
+		if (!METAENUMERATOR_CONSTANT_EVALUATED())
+			return any_vector<Operation>(a, b);
+#endif
+		
+		return any_scalar<Operation>(a, b);
+	}
+	
+	template <typename Operation>
+	static inline constexpr void transform_scalar(OperandType* result, const OperandType* a, const OperandType* b, size_t start = 0)
+	{
+		for (size_t i = start; i < OperandCount; ++i)
+		{
+			result[i] = Operation::apply(a[i], b[i]);
+		}
+	}
+	
+	template <typename Operation>
+	static inline constexpr bool any_scalar(const OperandType* a, const OperandType* b, size_t start = 0)
+	{
+		OperandType accumulator = 0;
+		
+		for (size_t i = start; i < OperandCount; ++i)
+		{
+			accumulator |= Operation::apply(a[i], b[i]);
+		}
+		
+		return accumulator != 0;
+	}
+	
+#if defined(METAENUMERATOR_SIMD)
+	template <typename Operation>
+	static inline void transform_vector(OperandType* result, const OperandType* a, const OperandType* b)
+	{
+		auto r = reinterpret_cast<char*>(result);
+		auto pa = reinterpret_cast<const char*>(a);
+		auto pb = reinterpret_cast<const char*>(b);
+		size_t offset = 0;
+		
+	#if defined(METAENUMERATOR_AVX512)
+		for (; offset + sizeof(__m512i) <= BYTE_COUNT; offset += sizeof(__m512i))
+			_mm512_storeu_si512(r + offset, Operation::apply(_mm512_loadu_si512(pa + offset), _mm512_loadu_si512(pb + offset)));
+	#endif
+	#if defined(METAENUMERATOR_AVX2)
+		for (; offset + sizeof(__m256i) <= BYTE_COUNT; offset += sizeof(__m256i))
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(r + offset), Operation::apply(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pa + offset)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + offset))));
+	#endif
+	#if defined(METAENUMERATOR_SSE2)
+		for (; offset + sizeof(__m128i) <= BYTE_COUNT; offset += sizeof(__m128i))
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(r + offset), Operation::apply(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(pa + offset)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + offset))));
+	#endif
+		
+		transform_scalar<Operation>(result, a, b, VECTOR_TAIL);
+	}
+	
+	template <typename Operation>
+	static inline bool any_vector(const OperandType* a, const OperandType* b)
+	{
+		auto pa = reinterpret_cast<const char*>(a);
+		auto pb = reinterpret_cast<const char*>(b);
+		size_t offset = 0;
+		
+	#if defined(METAENUMERATOR_AVX512)
+		if (offset + sizeof(__m512i) <= BYTE_COUNT)
+		{
+			__m512i accumulator = _mm512_setzero_si512();
+			
+			for (; offset + sizeof(__m512i) <= BYTE_COUNT; offset += sizeof(__m512i))
+				accumulator = _mm512_or_si512(accumulator, Operation::apply(_mm512_loadu_si512(pa + offset), _mm512_loadu_si512(pb + offset)));
+			
+			if (_mm512_test_epi64_mask(accumulator, accumulator) != 0)
+				return true;
+		}
+	#endif
+	#if defined(METAENUMERATOR_AVX2)
+		if (offset + sizeof(__m256i) <= BYTE_COUNT)
+		{
+			__m256i accumulator = _mm256_setzero_si256();
+			
+			for (; offset + sizeof(__m256i) <= BYTE_COUNT; offset += sizeof(__m256i))
+				accumulator = _mm256_or_si256(accumulator, Operation::apply(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pa + offset)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + offset))));
+			
+			if (!_mm256_testz_si256(accumulator, accumulator))
+				return true;
+		}
+	#endif
+	#if defined(METAENUMERATOR_SSE2)
+		if (offset + sizeof(__m128i) <= BYTE_COUNT)
+		{
+			__m128i accumulator = _mm_setzero_si128();
+			
+			for (; offset + sizeof(__m128i) <= BYTE_COUNT; offset += sizeof(__m128i))
+				accumulator = _mm_or_si128(accumulator, Operation::apply(
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(pa + offset)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + offset))));
+			
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(accumulator, _mm_setzero_si128())) != 0xFFFF)
+				return true;
+		}
+	#endif
+		
+		return any_scalar<Operation>(a, b, VECTOR_TAIL);
+	}
+#endif
+};
+
 template <size_t BitLength>
 class EnumeratorDataContainer
 {
@@ -29,13 +389,15 @@ public:
 	
 public:
 	using MemoryType = unsigned char;
-	using OperandType = unsigned int;
+	// Use 64-bit operands on 64-bit targets to halve the amount of operations per mask
+	using OperandType = typename std::conditional<sizeof(void*) >= sizeof(unsigned long long), unsigned long long, unsigned int>::type;
 	static constexpr const size_t MEMORY_BITS = sizeof(MemoryType) * CHAR_BIT;
 	static constexpr const MemoryType MEMORY_MASK = std::numeric_limits<MemoryType>::max();
 	static constexpr const size_t OPERAND_BITS = sizeof(OperandType) * CHAR_BIT;
 	static constexpr const size_t OPERAND_COUNT = (BitLength / OPERAND_BITS) + (BitLength % OPERAND_BITS != 0 ? 1 : 0);
 	static constexpr const size_t ROUNDED_BITLENGTH = OPERAND_COUNT * OPERAND_BITS;
 	static constexpr const size_t ARRAY_SIZE = (ROUNDED_BITLENGTH / MEMORY_BITS) + (ROUNDED_BITLENGTH % MEMORY_BITS != 0 ? 1 : 0);
+	using Kernel = EnumeratorDataKernel<OperandType, OPERAND_COUNT>;
 	
 	static inline constexpr EnumeratorDataContainer max()
 	{
@@ -56,18 +418,12 @@ public:
 	
 	inline explicit constexpr operator bool() const
 	{
-		return !equals(0);
+		return Kernel::template any<EnumeratorBitOr>(_data, _data);
 	}
 	
 	inline constexpr bool equals(const EnumeratorDataContainer& other) const
 	{
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			if (_data[i] != other._data[i])
-				return false;
-		}
-		
-		return true;
+		return !Kernel::template any<EnumeratorBitXor>(_data, other._data);
 	}
 	
 	inline constexpr bool equals(OperandType other) const
@@ -75,7 +431,7 @@ public:
 		if (_data[0] != other)
 			return false;
 		
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
+		for (size_t i = 1; i < OPERAND_COUNT; ++i)
 		{
 			if (_data[i] != 0)
 				return false;
@@ -118,11 +474,7 @@ public:
 	inline constexpr EnumeratorDataContainer operator&(const EnumeratorDataContainer& other) const
 	{
 		EnumeratorDataContainer r{};
-		
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			r._data[i] = _data[i] & other._data[i];
-		}
+		Kernel::template transform<EnumeratorBitAnd>(r._data, _data, other._data);
 		
 		return r;
 	}
@@ -143,10 +495,7 @@ public:
 	
 	inline constexpr EnumeratorDataContainer operator&=(const EnumeratorDataContainer& other)
 	{
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			_data[i] = _data[i] & other._data[i];
-		}
+		Kernel::template transform<EnumeratorBitAnd>(_data, _data, other._data);
 		
 		return *this;
 	}
@@ -166,11 +515,7 @@ public:
 	inline constexpr EnumeratorDataContainer operator|(const EnumeratorDataContainer& other) const
 	{
 		EnumeratorDataContainer r{};
-		
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			r._data[i] = _data[i] | other._data[i];
-		}
+		Kernel::template transform<EnumeratorBitOr>(r._data, _data, other._data);
 		
 		return r;
 	}
@@ -191,10 +536,7 @@ public:
 	
 	inline constexpr EnumeratorDataContainer operator|=(const EnumeratorDataContainer& other)
 	{
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			_data[i] = _data[i] | other._data[i];
-		}
+		Kernel::template transform<EnumeratorBitOr>(_data, _data, other._data);
 		
 		return *this;
 	}
@@ -209,11 +551,7 @@ public:
 	inline constexpr EnumeratorDataContainer operator^(const EnumeratorDataContainer& other) const
 	{
 		EnumeratorDataContainer r{};
-		
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			r._data[i] = _data[i] ^ other._data[i];
-		}
+		Kernel::template transform<EnumeratorBitXor>(r._data, _data, other._data);
 		
 		return r;
 	}
@@ -234,10 +572,7 @@ public:
 	
 	inline constexpr EnumeratorDataContainer operator^=(const EnumeratorDataContainer& other)
 	{
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			_data[i] = _data[i] ^ other._data[i];
-		}
+		Kernel::template transform<EnumeratorBitXor>(_data, _data, other._data);
 		
 		return *this;
 	}
@@ -257,11 +592,7 @@ public:
 	inline constexpr EnumeratorDataContainer operator~() const
 	{
 		EnumeratorDataContainer r{};
-		
-		for (size_t i = 0; i < OPERAND_COUNT; ++i)
-		{
-			r._data[i] = ~_data[i];
-		}
+		Kernel::template transform<EnumeratorBitNot>(r._data, _data, _data);
 		
 		return r;
 	}
@@ -335,719 +666,4392 @@ public:
 };
 
 
-template <typename EnumType, typename DataType, size_t bit_length, bool isFlags>
-class EnumeratorConverter
+template <size_t bit_length, typename = void>
+struct EnumeratorWideDataType
 {
-public:
-	static inline constexpr DataType get_data(EnumType value)
+	using type = EnumeratorDataContainer<bit_length>;
+};
+
+#if defined(METAENUMERATOR_INT128)
+template <size_t bit_length>
+struct EnumeratorWideDataType<bit_length, typename std::enable_if<(bit_length <= 128)>::type>
+{
+	using type = EnumeratorUInt128;
+};
+#endif
+
+
+// Word-wise access to the storage of a mask, built-in types are split in 64-bit words
+template <typename DataType, typename = void>
+struct EnumeratorDataWords
+{
+	using WordType = unsigned long long;
+	static constexpr const size_t WORD_BITS = std::numeric_limits<WordType>::digits;
+	static constexpr const size_t WORD_COUNT = (sizeof(DataType) + sizeof(WordType) - 1) / sizeof(WordType);
+	
+	static inline constexpr WordType get_word(const DataType& data, size_t index)
 	{
-		auto data_value = static_cast<typename std::make_unsigned<EnumType>::type>(value);
+		return static_cast<WordType>(data >> (index * WORD_BITS));
+	}
+	
+	static inline constexpr void set_word(DataType& data, size_t index, WordType word)
+	{
+		const size_t shift = index * WORD_BITS;
+		data = static_cast<DataType>((data & ~(static_cast<DataType>(~static_cast<WordType>(0)) << shift)) | (static_cast<DataType>(word) << shift));
+	}
+};
+
+template <size_t BitLength>
+struct EnumeratorDataWords<EnumeratorDataContainer<BitLength>>
+{
+	using DataType = EnumeratorDataContainer<BitLength>;
+	using WordType = typename DataType::OperandType;
+	static constexpr const size_t WORD_BITS = DataType::OPERAND_BITS;
+	static constexpr const size_t WORD_COUNT = DataType::OPERAND_COUNT;
+	
+	static inline constexpr WordType get_word(const DataType& data, size_t index)
+	{
+		return data._data[index];
+	}
+	
+	static inline constexpr void set_word(DataType& data, size_t index, WordType word)
+	{
+		data._data[index] = word;
+	}
+};
+
+// Word type used to store a mask one word at a time, the storage itself for built-in types of up to 64 bits
+template <typename DataType>
+using EnumeratorStorageWordType = typename std::conditional<
+		!std::is_class<DataType>::value && (sizeof(DataType) <= sizeof(unsigned long long)), DataType, typename EnumeratorDataWords<DataType>::WordType
+>::type;
+
+// Storages whose memory is nothing but the bits of the mask, from bit 0 upwards in native word order
+template <typename DataType>
+struct enumerator_is_plain_storage : std::integral_constant<bool, !std::is_class<DataType>::value> { };
+
+template <size_t BitLength>
+struct enumerator_is_plain_storage<EnumeratorDataContainer<BitLength>> : std::true_type { };
+
+// Bit queries on the storage of a mask, skipping whole zero words. Bit positions are 0-based and bits at or past bit_count are ignored
+template <typename DataType>
+struct EnumeratorDataBits
+{
+	using Words = EnumeratorDataWords<DataType>;
+	using WordType = typename Words::WordType;
+	static constexpr const size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+	
+	// Returns the position of the first set bit at or after bit, NOT_FOUND if there is none
+	static inline constexpr size_t find_next(const DataType& data, size_t bit, size_t bit_count)
+	{
+		if (bit >= bit_count)
+			return NOT_FOUND;
 		
-		if (data_value > bit_length)
-			return static_cast<DataType>(0);
+		size_t index = bit / Words::WORD_BITS;
+		WordType word = Words::get_word(data, index) & static_cast<WordType>(~static_cast<WordType>(0) << (bit % Words::WORD_BITS));
 		
-		if (data_value == 0)
-			return 0;
+		while (word == 0)
+		{
+			if (++index >= Words::WORD_COUNT || index * Words::WORD_BITS >= bit_count)
+				return NOT_FOUND;
+			
+			word = Words::get_word(data, index);
+		}
 		
-		return static_cast<DataType>(1) << (data_value - 1);
+		const size_t found = index * Words::WORD_BITS + EnumeratorBits::count_trailing_zeros(word);
+		return found < bit_count ? found : NOT_FOUND;
 	}
 	
-	static inline constexpr EnumType get_value(DataType data)
+	// Returns the position of the last set bit at or before bit, NOT_FOUND if there is none
+	static inline constexpr size_t find_prev(const DataType& data, size_t bit, size_t bit_count)
 	{
-		if (data == 0)
-			return static_cast<EnumType>(0);
+		if (bit_count == 0)
+			return NOT_FOUND;
 		
-		DataType i=0;
-		while( !((data >> i++) & 0x01) ) { ; }
-		return static_cast<EnumType>(i);
+		if (bit >= bit_count)
+			bit = bit_count - 1;
+		
+		size_t index = bit / Words::WORD_BITS;
+		WordType word = Words::get_word(data, index) & static_cast<WordType>(~static_cast<WordType>(0) >> (Words::WORD_BITS - 1 - bit % Words::WORD_BITS));
+		
+		while (word == 0)
+		{
+			if (index == 0)
+				return NOT_FOUND;
+			
+			word = Words::get_word(data, --index);
+		}
+		
+		return index * Words::WORD_BITS + Words::WORD_BITS - 1 - EnumeratorBits::count_leading_zeros(word);
 	}
 	
-	static inline constexpr EnumType get_bit(size_t index)
+	// Returns the amount of set bits
+	static inline constexpr size_t count(const DataType& data, size_t bit_count)
 	{
-		return static_cast<EnumType>(index);
+		size_t total = 0;
+		
+		for (size_t index = 0; index < Words::WORD_COUNT && index * Words::WORD_BITS < bit_count; ++index)
+		{
+			total += EnumeratorBits::popcount(Words::get_word(data, index) & usedBits(index, bit_count));
+		}
+		
+		return total;
+	}
+	
+	// Returns the position of the rank-th (0-based) set bit, NOT_FOUND if there are rank set bits or less
+	static inline constexpr size_t select(const DataType& data, size_t rank, size_t bit_count)
+	{
+		for (size_t index = 0; index < Words::WORD_COUNT && index * Words::WORD_BITS < bit_count; ++index)
+		{
+			const WordType word = Words::get_word(data, index) & usedBits(index, bit_count);
+			const size_t population = EnumeratorBits::popcount(word);
+			
+			if (rank < population)
+				return index * Words::WORD_BITS + EnumeratorBits::select(word, rank);
+			
+			rank -= population;
+		}
+		
+		return NOT_FOUND;
+	}
+	
+protected:
+	// Returns the bits of the word at index which are below bit_count
+	static inline constexpr WordType usedBits(size_t index, size_t bit_count)
+	{
+		const size_t remaining = bit_count - index * Words::WORD_BITS;
+		
+		if (remaining >= Words::WORD_BITS)
+			return static_cast<WordType>(~static_cast<WordType>(0));
+		
+		return static_cast<WordType>((static_cast<WordType>(1) << remaining) - 1);
 	}
 };
 
-template <typename EnumType, typename DataType, size_t bit_length>
-class EnumeratorConverter<EnumType, DataType, bit_length, true>
+// Mask storage for huge enums where masks only hold a few values: up to Capacity set bits are kept as a sorted array of positions,
+// masks with more set bits fall back to an EnumeratorDataContainer allocated on the heap. Results are always brought back to the array
+// form when they fit, so both forms never describe the same value. Allocation failures terminate, as for the rest of the masks API
+template <size_t BitLength, size_t Capacity = 8>
+class EnumeratorSparseContainer
 {
 public:
-	static inline constexpr DataType get_data(EnumType value)
+	using DenseType = EnumeratorDataContainer<BitLength>;
+	using OperandType = typename DenseType::OperandType;
+	using PositionType = typename std::conditional<(BitLength <= 65536), uint16_t, uint32_t>::type;
+	static constexpr const size_t BIT_LENGTH = BitLength;
+	static constexpr const size_t CAPACITY = Capacity;
+	
+	static_assert(Capacity > 0 && Capacity <= std::numeric_limits<unsigned char>::max(), "EnumeratorSparseContainer: Capacity must be between 1 and 255");
+	
+	static inline EnumeratorSparseContainer max()
 	{
-		static_cast<DataType>(value);
+		return EnumeratorSparseContainer(DenseType::max());
 	}
 	
-	static inline constexpr EnumType get_value(DataType data)
+public:
+	EnumeratorSparseContainer() noexcept = default;
+	EnumeratorSparseContainer(EnumeratorSparseContainer&& other) noexcept = default;
+	
+	EnumeratorSparseContainer(const EnumeratorSparseContainer& other) noexcept : _positions{}, _count{other._count}
 	{
-		static_cast<EnumType>(data);
+		std::memcpy(_positions, other._positions, sizeof(_positions));
+		
+		if (other._dense)
+			_dense.reset(new DenseType(*other._dense));
 	}
 	
-	static inline constexpr EnumType get_bit(size_t index)
+	EnumeratorSparseContainer(OperandType value) noexcept
 	{
-		return static_cast<EnumType>(1 << index);
+		for (; value != 0 && _count < Capacity; value &= value - 1)
+		{
+			auto position = EnumeratorBits::count_trailing_zeros(value);
+			
+			if (position < BitLength)
+				_positions[_count++] = static_cast<PositionType>(position);
+		}
+		
+		if (value != 0)
+			assign(toDense() | DenseType(value));
 	}
-};
-
-template <typename EnumType>
-class EnumeratorMeta
-{
-};
-
-template <typename EnumType>
-class EnumeratorInherited
-{
-public:
-	using InheritedType = EnumType;
-};
-
-template<typename T, typename = void>
-struct enumerator_has_extension_meta : std::false_type { };
-template<typename T>
-struct enumerator_has_extension_meta<T, decltype((void)EnumeratorMeta<T>::enum_extension, void())> : std::true_type { };
-
-template<typename T, typename = void>
-struct enumerator_has_extension_value : std::false_type { };
-template<typename T>
-struct enumerator_has_extension_value<T, decltype((void)T::EXTENSION, void())> : std::true_type { };
-
-template<typename T>
-struct enumerator_has_extension : std::integral_constant<bool, enumerator_has_extension_meta<T>::value || enumerator_has_extension_value<T>::value> { };
-
-template<typename T, typename = void>
-struct enumerator_has_inheritance_meta : std::false_type { };
-template<typename T>
-struct enumerator_has_inheritance_meta<T, decltype((void)EnumeratorMeta<T>::enum_inheritance, void())> : std::true_type { };
-
-template<typename T, typename = void>
-struct enumerator_has_inheritance_value : std::false_type { };
-template<typename T>
-struct enumerator_has_inheritance_value<T, decltype((void)T::INHERITANCE, void())> : std::true_type { };
-
-template<typename T>
-struct enumerator_has_inheritance : std::integral_constant<bool, enumerator_has_inheritance_meta<T>::value || enumerator_has_inheritance_value<T>::value> { };
-
-template<typename T, typename = void>
-struct enumerator_has_base_type : std::false_type { };
-template<typename T>
-struct enumerator_has_base_type<T, decltype((void)typename EnumeratorMeta<T>::BaseEnumType(), void())> : std::true_type { };
-
-
-template <typename EnumType>
-class EnumeratorInfo
-{
-	template <typename>
-	friend class EnumeratorInfo;
 	
-protected:
-	using Meta = EnumeratorMeta<EnumType>;
-	using DataType = typename Meta::DataType;
-	using Extender = typename Meta::Extender;
-	using Inheritor = typename Meta::Inheritor;
+	explicit EnumeratorSparseContainer(const DenseType& dense) noexcept
+	{
+		assign(dense);
+	}
 	
-public:
-	using EntryType = typename std::remove_const< typename std::remove_reference< typename std::remove_pointer< decltype(Meta::enum_entries[0]) >::type >::type >::type;
-	static constexpr const size_t ENTRY_COUNT = sizeof(EnumeratorMeta<EnumType>::enum_entries) / sizeof(EntryType);
+	EnumeratorSparseContainer& operator=(EnumeratorSparseContainer&& other) noexcept = default;
 	
-	struct Result
+	EnumeratorSparseContainer& operator=(const EnumeratorSparseContainer& other) noexcept
 	{
-		friend class EnumeratorInfo;
-		
-	public:
-		constexpr Result() = default;
-		
-		constexpr explicit operator bool() const { return _ptr != nullptr; }
-		constexpr const EntryType& operator*() const { return *_ptr; }
-		constexpr const EntryType* operator->() { return _ptr; }
-		constexpr const EntryType* pointer() { return _ptr; }
-		
-	protected:
-		constexpr Result(const EntryType* entry) : _ptr{entry} {}
+		if (this != &other)
+			*this = EnumeratorSparseContainer(other);
 		
-	protected:
-		const EntryType* _ptr{};
-	};
+		return *this;
+	}
 	
-	struct Iterator
+public:
+	// Returns the heap allocated storage, nullptr while the bits are held in the positions array
+	const DenseType* get_dense() const
 	{
-	public:
-		using iterator_category = std::input_iterator_tag;
-		using difference_type   = std::ptrdiff_t;
-		using value_type        = EntryType;
-		using pointer           = const EntryType*;
-		using reference         = const EntryType&;
-		
-	public:
-		constexpr Iterator(pointer ptr) : _ptr{ptr} { }
-		
-		reference operator*() const { return *_ptr; }
-		pointer operator->() { return _ptr; }
+		return _dense.get();
+	}
 	
-		Iterator& operator++() { _ptr++; return *this; }  
-		Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+	const PositionType* get_positions() const
+	{
+		return _positions;
+	}
 	
-		friend bool operator== (const Iterator& a, const Iterator& b) { return a._ptr == b._ptr; };
-		friend bool operator!= (const Iterator& a, const Iterator& b) { return a._ptr != b._ptr; };     
-		
-	private:
-		pointer _ptr;
-	};
+	size_t get_count() const
+	{
+		return _count;
+	}
 	
-	static constexpr Iterator cbegin() { return Iterator(EnumeratorMeta<EnumType>::enum_entries); }
-	static constexpr Iterator cend() { return Iterator(EnumeratorMeta<EnumType>::enum_entries + ENTRY_COUNT);}
+	inline explicit operator bool() const
+	{
+		return _count > 0 || _dense;
+	}
 	
-public:
-	static constexpr Result find(EnumType value)
+	inline bool equals(const EnumeratorSparseContainer& other) const
 	{
-		auto result = findQuick(value);
-		if (result)
-			return result;
+		if (_dense || other._dense)
+			return _dense && other._dense && *_dense == *other._dense;
 		
-		return findSlow(value);
+		return _count == other._count && std::equal(_positions, _positions + _count, other._positions);
 	}
 	
-	static constexpr Result find(const char* name)
+	inline bool operator==(const EnumeratorSparseContainer& other) const
 	{
-		Result result = findSelf(name);
-		if (result)
-			return result;
-		result = findInherited(name);
-		if (result)
-			return result;
-		result = findExtended(name);
-		if (result)
-			return result;
-		
-		return {};
+		return equals(other);
 	}
 	
-protected:
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_base_type<T>::value, int>::type = 0>
-	static constexpr size_t getQuickIndex(EnumType value)
+	inline bool operator!=(const EnumeratorSparseContainer& other) const
 	{
-		using BaseMeta = EnumeratorMeta<typename EnumeratorMeta<T>::BaseEnumType>;
-		using BaseInheritor = typename BaseMeta::Inheritor;
-		auto dataValue = static_cast<DataType>(value);
-		auto dataMin = static_cast<DataType>(BaseInheritor::get_inheritance());
-		auto index = static_cast<size_t>(dataValue - dataMin) + 1;
-		
-		return index;
+		return !equals(other);
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_base_type<T>::value, int>::type = 0>
-	static constexpr size_t getQuickIndex(EnumType value)
+	inline bool has_bit(size_t bit) const
 	{
-		auto dataValue = static_cast<DataType>(value);
-		auto dataMin = static_cast<DataType>(Meta::MIN_VALUE);
-		auto index = static_cast<size_t>(dataValue - dataMin);
+		if (_dense)
+			return _dense->has_bit(bit);
 		
-		return index;
+		return std::binary_search(_positions, _positions + _count, static_cast<PositionType>(bit));
 	}
 	
-	static constexpr Result findQuickSelf(EnumType value)
+	inline EnumeratorSparseContainer operator&(const EnumeratorSparseContainer& other) const
 	{
-		auto index = getQuickIndex(value);
-		
-		if (index < ENTRY_COUNT)
+		// The intersection is never larger than the sparse operand, which only needs to be filtered
+		if (!_dense || !other._dense)
 		{
-			auto&& entry = EnumeratorMeta<EnumType>::enum_entries[index];
-			if (entry.get_value() == value)
-				return {&entry};
+			auto&& sparse = _dense ? other : *this;
+			auto&& filter = _dense ? *this : other;
+			EnumeratorSparseContainer r{};
+			
+			for (size_t i = 0; i < sparse._count; ++i)
+			{
+				if (filter.has_bit(sparse._positions[i]))
+					r._positions[r._count++] = sparse._positions[i];
+			}
+			
+			return r;
 		}
 		
-		// Special case if enum_entries skips the first 0-valued entry
-		if (index > 0 && index <= ENTRY_COUNT)
+		return EnumeratorSparseContainer(*_dense & *other._dense);
+	}
+	
+	inline EnumeratorSparseContainer operator|(const EnumeratorSparseContainer& other) const
+	{
+		return combine<EnumeratorBitOr>(other);
+	}
+	
+	inline EnumeratorSparseContainer operator^(const EnumeratorSparseContainer& other) const
+	{
+		return combine<EnumeratorBitXor>(other);
+	}
+	
+	inline EnumeratorSparseContainer& operator&=(const EnumeratorSparseContainer& other)
+	{
+		return *this = *this & other;
+	}
+	
+	inline EnumeratorSparseContainer& operator|=(const EnumeratorSparseContainer& other)
+	{
+		return *this = *this | other;
+	}
+	
+	inline EnumeratorSparseContainer& operator^=(const EnumeratorSparseContainer& other)
+	{
+		return *this = *this ^ other;
+	}
+	
+	inline EnumeratorSparseContainer operator~() const
+	{
+		return EnumeratorSparseContainer(~toDense() & DenseType::max() >> (DenseType::ROUNDED_BITLENGTH - BitLength));
+	}
+	
+	inline EnumeratorSparseContainer operator<<(size_t bits) const
+	{
+		if (_dense)
+			return EnumeratorSparseContainer(*_dense << bits & DenseType::max() >> (DenseType::ROUNDED_BITLENGTH - BitLength));
+		
+		EnumeratorSparseContainer r{};
+		
+		for (size_t i = 0; i < _count && _positions[i] + bits < BitLength; ++i)
 		{
-			auto&& entry = EnumeratorMeta<EnumType>::enum_entries[index - 1];
-			if (entry.get_value() == value)
-				return {&entry};
+			r._positions[r._count++] = static_cast<PositionType>(_positions[i] + bits);
 		}
 		
-		return {};
+		return r;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance<T>::value && !std::is_same<T, typename EnumeratorInherited<T>::InheritedType>::value, int>::type = 0>
-	static constexpr Result findQuickInherited(EnumType value)
+	inline EnumeratorSparseContainer operator>>(size_t bits) const
 	{
-		using InheritedType = typename EnumeratorInherited<T>::InheritedType;
-		using InheritedInfo = EnumeratorInfo<InheritedType>;
+		if (_dense)
+			return EnumeratorSparseContainer(*_dense >> bits);
 		
-		auto inheritance = Inheritor::get_inheritance();
-		auto dataValue = static_cast<DataType>(value);
-		auto dataInheritance = static_cast<DataType>(inheritance);
+		EnumeratorSparseContainer r{};
 		
-		if (dataValue >= dataInheritance)
+		for (size_t i = 0; i < _count; ++i)
 		{
-			return { InheritedInfo::find(static_cast<InheritedType>(value)).pointer() };
+			if (_positions[i] >= bits)
+				r._positions[r._count++] = static_cast<PositionType>(_positions[i] - bits);
 		}
 		
-		return {};
+		return r;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_inheritance<T>::value || std::is_same<T, typename EnumeratorInherited<T>::InheritedType>::value, int>::type = 0>
-	static constexpr Result findQuickInherited(EnumType)
+	inline OperandType get_word(size_t index) const
 	{
-		return {};
+		if (_dense)
+			return _dense->_data[index];
+		
+		OperandType word = 0;
+		
+		for (size_t i = 0; i < _count; ++i)
+		{
+			if (_positions[i] / DenseType::OPERAND_BITS == index)
+				word |= static_cast<OperandType>(1) << (_positions[i] % DenseType::OPERAND_BITS);
+		}
+		
+		return word;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr Result findQuickExtended(EnumType value)
+	// Updates the bits of one word in place, so that filling a mask word by word doesn't go through the dense form on every call
+	inline void set_word(size_t index, OperandType word)
 	{
-		auto extension = Extender::get_extension();
-		auto dataValue = static_cast<DataType>(value);
-		auto dataExtension = static_cast<DataType>(extension);
+		const size_t first = index * DenseType::OPERAND_BITS;
 		
-		if (dataValue >= dataExtension)
+		if (BitLength - first < DenseType::OPERAND_BITS)
+			word &= (static_cast<OperandType>(1) << (BitLength - first)) - 1;
+		
+		if (_dense)
 		{
-			auto index = static_cast<size_t>(dataValue - dataExtension);
-			auto&& container = Extender::get_container();
+			auto previous = _dense->_data[index];
+			_dense->_data[index] = word;
 			
-			// Note: because of how enum extensions work, we don't need an equivalent findSlow() for extensions
-			if (index < container.ENTRY_COUNT)
+			// Only clearing bits can bring the mask back under Capacity
+			if (EnumeratorBits::popcount(word) < EnumeratorBits::popcount(previous) && EnumeratorDataBits<DenseType>::count(*_dense, BitLength) <= Capacity)
 			{
-				auto&& entry = container.enum_entries[index];
-				if (entry.get_value() == value)
-					return {&entry};
+				auto dense = std::move(_dense);
+				assign(*dense);
 			}
+			
+			return;
 		}
 		
-		return {};
-	}
-	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr Result findQuickExtended(EnumType)
-	{	
-		return {};
-	}
-	
-	static constexpr Result findQuick(EnumType value)
-	{
-		// Return if the enum values aren't sequential, i.e. their values are already bitflags (isFlags parameter passed to EnumeratorMetaDefault was true)
-		if (!EnumeratorMeta<EnumType>::bitwise_conversion)
-			return {};
+		// The positions of the word are a contiguous run of the sorted array
+		auto begin = std::lower_bound(_positions, _positions + _count, first);
+		auto end = std::lower_bound(begin, _positions + _count, first + DenseType::OPERAND_BITS);
+		auto count = _count - static_cast<size_t>(end - begin) + EnumeratorBits::popcount(word);
 		
-		Result result = findQuickSelf(value);
-		if (result)
-			return result;
-		result = findQuickInherited(value);
-		if (result)
-			return result;
-		result = findQuickExtended(value);
-		if (result)
-			return result;
+		if (count > Capacity)
+		{
+			auto dense = toDense();
+			dense._data[index] = word;
+			_dense.reset(new DenseType(dense));
+			_count = 0;
+			return;
+		}
 		
-		return {};
-	}
-	
-	static constexpr Result findSlow(EnumType value)
-	{
-		auto it = cbegin();
-		auto end = cend();
+		PositionType tail[Capacity];
+		auto tail_count = static_cast<size_t>(_positions + _count - end);
+		std::copy(end, _positions + _count, tail);
 		
-		for (; it != end; ++it)
+		auto position = begin;
+		
+		for (; word != 0; word &= word - 1)
 		{
-			auto&& entry = *it;
-			
-			if (entry.get_value() == value)
-				return {&entry};
+			*position++ = static_cast<PositionType>(first + EnumeratorBits::count_trailing_zeros(word));
 		}
 		
-		return {};
+		std::copy(tail, tail + tail_count, position);
+		_count = static_cast<unsigned char>(count);
 	}
 	
-	static constexpr bool matchEntry(const EntryType& entry, const char* name)
+protected:
+	// Merges the sorted positions when both operands are sparse, goes through the dense form otherwise
+	template <typename Operation>
+	inline EnumeratorSparseContainer combine(const EnumeratorSparseContainer& other) const
 	{
-		if (entry.get_name() == name)
-			return true;
-		else
+		if (_dense || other._dense)
+			return EnumeratorSparseContainer(Operation::apply(toDense(), other.toDense()));
+		
+		PositionType merged[Capacity * 2];
+		size_t count = 0, i = 0, j = 0;
+		
+		while (i < _count || j < other._count)
 		{
-			if (name != nullptr && entry.get_name() != nullptr)
+			if (j == other._count || (i < _count && _positions[i] < other._positions[j]))
 			{
-				auto nameP = name;
-				auto itName = entry.get_name();
+				if (Operation::apply(1u, 0u))
+					merged[count++] = _positions[i];
 				
-				while (*itName != '\0' && *nameP != '\0' && *itName == *nameP)
-				{
-					itName++;
-					nameP++;
-				}
+				++i;
+			}
+			else if (i == _count || other._positions[j] < _positions[i])
+			{
+				if (Operation::apply(0u, 1u))
+					merged[count++] = other._positions[j];
+				
+				++j;
+			}
+			else
+			{
+				if (Operation::apply(1u, 1u))
+					merged[count++] = _positions[i];
 				
-				if (*itName == '\0' && *nameP == '\0')
-					return true;
+				++i;
+				++j;
 			}
 		}
 		
-		return false;
-	}
-	
-	static constexpr Result findSelf(const char* name)
-	{
-		auto it = cbegin();
-		auto end = cend();
+		EnumeratorSparseContainer r{};
 		
-		for (; it != end; ++it)
+		if (count <= Capacity)
+		{
+			std::memcpy(r._positions, merged, count * sizeof(PositionType));
+			r._count = static_cast<unsigned char>(count);
+		}
+		else
 		{
-			auto&& entry = *it;
+			r._dense.reset(new DenseType{});
 			
-			if (matchEntry(entry, name))
-				return {&entry};
+			for (size_t k = 0; k < count; ++k)
+				r._dense->_data[merged[k] / DenseType::OPERAND_BITS] |= static_cast<OperandType>(1) << (merged[k] % DenseType::OPERAND_BITS);
 		}
 		
-		return {};
+		return r;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance<T>::value && !std::is_same<T, typename EnumeratorInherited<T>::InheritedType>::value, int>::type = 0>
-	static constexpr Result findInherited(const char* name)
+	inline DenseType toDense() const
 	{
-		using InheritedType = typename EnumeratorInherited<T>::InheritedType;
-		using InheritedInfo = EnumeratorInfo<InheritedType>;
+		if (_dense)
+			return *_dense;
 		
-		return { InheritedInfo::find(name).pointer() };
-	}
-	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_inheritance<T>::value || std::is_same<T, typename EnumeratorInherited<T>::InheritedType>::value, int>::type = 0>
-	static constexpr Result findInherited(const char*)
-	{
-		return {};
+		DenseType dense{};
+		
+		for (size_t i = 0; i < _count; ++i)
+		{
+			dense._data[_positions[i] / DenseType::OPERAND_BITS] |= static_cast<OperandType>(1) << (_positions[i] % DenseType::OPERAND_BITS);
+		}
+		
+		return dense;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr Result findExtended(const char* name)
+	inline void assign(const DenseType& dense)
 	{
-		auto&& container = Extender::get_container();
-		Iterator it(container.enum_entries);
-		Iterator end(container.enum_entries + container.ENTRY_COUNT);
+		using Bits = EnumeratorDataBits<DenseType>;
 		
-		for (; it != end; ++it)
+		if (Bits::count(dense, BitLength) > Capacity)
 		{
-			auto&& entry = *it;
+			if (_dense)
+				*_dense = dense;
+			else
+				_dense.reset(new DenseType(dense));
 			
-			if (matchEntry(entry, name))
-				return {&entry};
+			_count = 0;
+			return;
 		}
 		
-		return {};
+		_dense.reset();
+		_count = 0;
+		
+		for (auto bit = Bits::find_next(dense, 0, BitLength); bit != Bits::NOT_FOUND; bit = Bits::find_next(dense, bit + 1, BitLength))
+		{
+			_positions[_count++] = static_cast<PositionType>(bit);
+		}
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr Result findExtended(const char*)
-	{	
-		return {};
-	}
+protected:
+	PositionType _positions[Capacity]{};
+	unsigned char _count{};
+	std::unique_ptr<DenseType> _dense;
 };
 
-template <typename EnumType>
-class EnumeratorSerializer
+template <size_t BitLength, size_t Capacity>
+struct EnumeratorDataWords<EnumeratorSparseContainer<BitLength, Capacity>>
 {
-	using Info = EnumeratorInfo<EnumType>;
-	using EntryType = typename Info::EntryType;
+	using DataType = EnumeratorSparseContainer<BitLength, Capacity>;
+	using WordType = typename DataType::OperandType;
+	static constexpr const size_t WORD_BITS = DataType::DenseType::OPERAND_BITS;
+	static constexpr const size_t WORD_COUNT = DataType::DenseType::OPERAND_COUNT;
 	
-public:
-	static constexpr decltype(std::declval<EntryType>().get_name()) get_name(EnumType value)
+	static inline WordType get_word(const DataType& data, size_t index)
 	{
-		auto it = Info::find(value);
-		
-		if (it)
-			return it->get_name();
+		return data.get_word(index);
+	}
+	
+	static inline void set_word(DataType& data, size_t index, WordType word)
+	{
+		data.set_word(index, word);
+	}
+};
+
+template <size_t BitLength, size_t Capacity>
+struct EnumeratorDataBits<EnumeratorSparseContainer<BitLength, Capacity>>
+{
+	using DataType = EnumeratorSparseContainer<BitLength, Capacity>;
+	using DenseBits = EnumeratorDataBits<typename DataType::DenseType>;
+	static constexpr const size_t NOT_FOUND = DenseBits::NOT_FOUND;
+	
+	static inline size_t find_next(const DataType& data, size_t bit, size_t bit_count)
+	{
+		if (data.get_dense())
+			return DenseBits::find_next(*data.get_dense(), bit, bit_count);
 		
-		return nullptr;
+		for (size_t i = 0; i < data.get_count(); ++i)
+		{
+			const size_t position = data.get_positions()[i];
+			
+			if (position >= bit)
+				return position < bit_count ? position : NOT_FOUND;
+		}
+		
+		return NOT_FOUND;
 	}
 	
-	static constexpr decltype(std::declval<EntryType>().get_label()) get_label(EnumType value)
+	static inline size_t find_prev(const DataType& data, size_t bit, size_t bit_count)
 	{
-		auto it = Info::find(value);
+		if (data.get_dense())
+			return DenseBits::find_prev(*data.get_dense(), bit, bit_count);
 		
-		if (it)
-			return it->get_label();
+		for (size_t i = data.get_count(); i > 0; --i)
+		{
+			const size_t position = data.get_positions()[i - 1];
+			
+			if (position <= bit && position < bit_count)
+				return position;
+		}
 		
-		return nullptr;
+		return NOT_FOUND;
 	}
 	
-	static constexpr EnumType get_value(const char* name)
+	static inline size_t count(const DataType& data, size_t bit_count)
 	{
-		auto it = Info::find(name);
+		if (data.get_dense())
+			return DenseBits::count(*data.get_dense(), bit_count);
 		
-		if (it)
-			return it->get_value();
+		size_t total = 0;
 		
-		return EnumeratorMeta<EnumType>::Converter::get_value(0);
+		while (total < data.get_count() && data.get_positions()[total] < bit_count)
+			++total;
+		
+		return total;
+	}
+	
+	static inline size_t select(const DataType& data, size_t rank, size_t bit_count)
+	{
+		if (data.get_dense())
+			return DenseBits::select(*data.get_dense(), rank, bit_count);
+		
+		if (rank < data.get_count() && data.get_positions()[rank] < bit_count)
+			return data.get_positions()[rank];
+		
+		return NOT_FOUND;
 	}
 };
 
-template <typename EnumType>
-class EnumeratorExtender
+// Mask storage for masks of thousands of bits: next to the words, a summary keeps one bit per word telling whether that word is non-zero.
+// Emptiness tests, searches and iteration skip empty regions 64 words at a time and binary operations only visit the words which can
+// produce a non-zero result, e.g. an intersection skips every word where either operand has its summary bit cleared
+template <size_t BitLength>
+class EnumeratorSummaryContainer
 {
-protected:
-	using Meta = EnumeratorMeta<EnumType>;
-	using Info = EnumeratorInfo<EnumType>;
-	using EntryType = typename Info::EntryType;
-	using DataType = typename Meta::DataType;
-	static constexpr const DataType max_enum_value = static_cast<DataType>(Meta::MAX_VALUE);
-	
 public:
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr bool has_extension()
+	using DenseType = EnumeratorDataContainer<BitLength>;
+	using OperandType = typename DenseType::OperandType;
+	static constexpr const size_t OPERAND_BITS = DenseType::OPERAND_BITS;
+	static constexpr const size_t OPERAND_COUNT = DenseType::OPERAND_COUNT;
+	static constexpr const size_t SUMMARY_COUNT = (OPERAND_COUNT + OPERAND_BITS - 1) / OPERAND_BITS;
+	
+	static inline EnumeratorSummaryContainer max()
 	{
-		return true;
+		return EnumeratorSummaryContainer(DenseType::max());
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr bool has_extension()
+public:
+	inline EnumeratorSummaryContainer() noexcept : _data{}, _summary{}
+	{	}
+	
+	inline EnumeratorSummaryContainer(OperandType value) noexcept : _data{value}, _summary{}
 	{
-		return false;
+		_summary[0] = value != 0 ? 1 : 0;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension_meta<T>::value, int>::type = 0>
-	static constexpr T get_extension()
+	inline explicit EnumeratorSummaryContainer(const DenseType& dense) noexcept : _summary{}
 	{
-		return static_cast<T>(Meta::enum_extension);
+		for (size_t i = 0; i < OPERAND_COUNT; ++i)
+		{
+			setWord(i, dense._data[i]);
+		}
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension_value<T>::value && !enumerator_has_extension_meta<T>::value, int>::type = 0>
-	static constexpr T get_extension()
+public:
+	inline OperandType get_word(size_t index) const
 	{
-		return static_cast<T>(EnumType::EXTENSION);
+		return _data[index];
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr EnumType get_extension()
+	inline void set_word(size_t index, OperandType word)
 	{
-		static_assert(sizeof(T) == 0, "EnumeratorExtender requires the EnumeratorMeta to define an enum_extension variable or the enum to contain an EXTENSION value.");
+		setWord(index, word);
 	}
 	
-	template<EnumType extension>
-	struct Container
+	// Returns the summary word at index, bit i being set if word index * OPERAND_BITS + i is non-zero
+	inline OperandType get_summary(size_t index) const
 	{
-		static constexpr const size_t ENTRY_COUNT = max_enum_value - static_cast<DataType>(extension);
-		
-		EntryType enum_entries[ENTRY_COUNT]{};
-		EnumType enum_extension = extension;
-	};
+		return _summary[index];
+	}
 	
-	// Making this a templated function is an unfortunately required hack to build on MSVC
-	template<EnumType extension = get_extension()>
-	static Container<extension>& get_container()
+	inline explicit operator bool() const
 	{
-		static_assert (extension == get_extension(), "Do not pass a template parameter to this function, read comment above.");
-		static Container<extension> container{};
-		return container;
+		for (size_t i = 0; i < SUMMARY_COUNT; ++i)
+		{
+			if (_summary[i] != 0)
+				return true;
+		}
+		
+		return false;
 	}
 	
-	template <typename... Types>
-	static EnumType extend(Types... entries)
+	inline bool equals(const EnumeratorSummaryContainer& other) const
 	{
-		auto&& container = get_container<get_extension()>();
-		
-		if (static_cast<DataType>(container.enum_extension) <= max_enum_value)
+		for (size_t i = 0; i < SUMMARY_COUNT; ++i)
 		{
-			auto return_enum = container.enum_extension;
-			auto entry_index = static_cast<DataType>(return_enum) - static_cast<DataType>(get_extension());
-			container.enum_entries[entry_index] = EntryType{return_enum, entries...};
-			
-			container.enum_extension = static_cast<EnumType>(static_cast<DataType>(return_enum) + 1);
-			
-			return return_enum;
+			if (_summary[i] != other._summary[i])
+				return false;
 		}
 		
-		// This is not ideal, if extensions overflow we should throw? or at least assert?
-		return static_cast<EnumType>(0);
+		bool equal = true;
+		forEachWord(_summary, [&](size_t index) { equal = equal && _data[index] == other._data[index]; });
+		
+		return equal;
 	}
-};
-
-template <typename EnumType>
-class EnumeratorInheritor
-{
-protected:
-	using Meta = EnumeratorMeta<EnumType>;
-	using DataType = typename Meta::DataType;
-	static constexpr const DataType max_enum_value = static_cast<DataType>(Meta::MAX_VALUE);
 	
-public:
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance<T>::value, int>::type = 0>
-	static constexpr bool has_inheritance()
+	inline bool operator==(const EnumeratorSummaryContainer& other) const
 	{
-		return true;
+		return equals(other);
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_inheritance<T>::value, int>::type = 0>
-	static constexpr bool has_inheritance()
+	inline bool operator!=(const EnumeratorSummaryContainer& other) const
 	{
-		return false;
+		return !equals(other);
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance_meta<T>::value, int>::type = 0>
-	static constexpr T get_inheritance()
+	inline bool has_bit(size_t bit) const
 	{
-		return static_cast<T>(Meta::enum_inheritance);
+		return bit < OPERAND_COUNT * OPERAND_BITS && (_data[bit / OPERAND_BITS] >> (bit % OPERAND_BITS)) & 1;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance_value<T>::value && !enumerator_has_inheritance_meta<T>::value, int>::type = 0>
-	static constexpr T get_inheritance()
+	inline EnumeratorSummaryContainer operator&(const EnumeratorSummaryContainer& other) const
 	{
-		return static_cast<T>(EnumType::INHERITANCE);
+		EnumeratorSummaryContainer r = *this;
+		return r &= other;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_inheritance<T>::value, int>::type = 0>
-	static constexpr EnumType get_enum_inheritance()
+	inline EnumeratorSummaryContainer operator|(const EnumeratorSummaryContainer& other) const
 	{
-		static_assert(sizeof(T) == 0, "EnumeratorInheritor requires the EnumeratorMeta to define an enum_inheritance variable or the enum to contain an INHERITANCE value.");
+		EnumeratorSummaryContainer r = *this;
+		return r |= other;
 	}
 	
-	static constexpr DataType inherit()
+	inline EnumeratorSummaryContainer operator^(const EnumeratorSummaryContainer& other) const
 	{
-		return static_cast<DataType>(get_inheritance());
+		EnumeratorSummaryContainer r = *this;
+		return r ^= other;
 	}
 	
-	static constexpr DataType inheritMaximum()
+	inline EnumeratorSummaryContainer& operator&=(const EnumeratorSummaryContainer& other)
 	{
-		return max_enum_value;
+		for (size_t i = 0; i < SUMMARY_COUNT; ++i)
+		{
+			// Words missing from other are cleared without being read
+			for (auto cleared = _summary[i] & ~other._summary[i]; cleared != 0; cleared &= cleared - 1)
+				_data[i * OPERAND_BITS + EnumeratorBits::count_trailing_zeros(cleared)] = 0;
+			
+			_summary[i] &= other._summary[i];
+		}
+		
+		forEachWord(_summary, [&](size_t index) { setWord(index, _data[index] & other._data[index]); });
+		
+		return *this;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr DataType inheritExtension()
+	inline EnumeratorSummaryContainer& operator|=(const EnumeratorSummaryContainer& other)
 	{
-		return static_cast<DataType>(Meta::Extender::get_extension());
+		forEachWord(other._summary, [&](size_t index) { setWord(index, _data[index] | other._data[index]); });
+		
+		return *this;
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
-	static constexpr DataType inheritExtension()
+	inline EnumeratorSummaryContainer& operator^=(const EnumeratorSummaryContainer& other)
 	{
-		return inheritMaximum();
+		forEachWord(other._summary, [&](size_t index) { setWord(index, _data[index] ^ other._data[index]); });
+		
+		return *this;
 	}
-};
-
-template <typename EnumType>
-class EnumeratorSpecializer
-{
-protected:
-	using Meta = EnumeratorMeta<EnumType>;
-	using DataType = typename Meta::DataType;
 	
-public:
-	template <typename T = EnumType, typename std::enable_if<enumerator_has_base_type<T>::value, int>::type = 0>
-	static constexpr bool has_base()
+	inline EnumeratorSummaryContainer operator~() const
 	{
-		return true;
+		return EnumeratorSummaryContainer(~toDense());
 	}
 	
-	template <typename T = EnumType, typename std::enable_if<!enumerator_has_base_type<T>::value, int>::type = 0>
-	static constexpr bool has_base()
+	inline EnumeratorSummaryContainer operator<<(size_t bits) const
 	{
-		return false;
+		return EnumeratorSummaryContainer(toDense() << bits);
 	}
-};
-
-template <typename EnumType_>
-class SmartEnumerator
-{
-protected:
-	using Meta = EnumeratorMeta<EnumType_>;
-	
-public:
-	using EnumType = EnumType_;
-	using DataType = typename Meta::DataType;
-	
-public:
-	constexpr SmartEnumerator(EnumType value) : m_data(value) { }
-	
-	template<typename EnumT, typename std::enable_if<std::is_enum<EnumT>::value && (std::is_same<EnumT, typename Meta::BaseEnumType>::value || std::is_same<EnumType, typename EnumeratorMeta<EnumT>::BaseEnumType>::value), int>::type = 0>
-	constexpr SmartEnumerator(EnumT value) : SmartEnumerator(static_cast<DataType>(value)) { }
 	
-protected:
-	constexpr SmartEnumerator(DataType data) : m_data(static_cast<EnumType>(data)) { }
-	
-public:
-	constexpr DataType data() const
+	inline EnumeratorSummaryContainer operator>>(size_t bits) const
 	{
-		return m_data;
+		return EnumeratorSummaryContainer(toDense() >> bits);
 	}
 	
-	constexpr bool operator==(SmartEnumerator a) const
+protected:
+	inline void setWord(size_t index, OperandType word)
 	{
-		return m_data == a.m_data;
+		const auto bit = static_cast<OperandType>(1) << (index % OPERAND_BITS);
+		_data[index] = word;
+		
+		if (word != 0)
+			_summary[index / OPERAND_BITS] |= bit;
+		else
+			_summary[index / OPERAND_BITS] &= ~bit;
 	}
 	
-	constexpr bool operator==(EnumType a) const
+	inline DenseType toDense() const
 	{
-		return m_data == Meta::Converter::get_data(a);
+		DenseType dense{};
+		std::memcpy(dense._data, _data, sizeof(_data));
+		
+		return dense;
 	}
 	
-	constexpr bool operator!=(SmartEnumerator a) const
+	// Calls function(index) for every word whose bit is set in summary
+	template <typename Function>
+	static inline void forEachWord(const OperandType* summary, Function&& function)
 	{
-		return m_data != a.m_data;
+		for (size_t i = 0; i < SUMMARY_COUNT; ++i)
+		{
+			for (auto bits = summary[i]; bits != 0; bits &= bits - 1)
+				function(i * OPERAND_BITS + EnumeratorBits::count_trailing_zeros(bits));
+		}
 	}
 	
-	constexpr bool operator!=(EnumType a) const
+protected:
+	OperandType _data[OPERAND_COUNT];
+	OperandType _summary[SUMMARY_COUNT];
+};
+
+template <size_t BitLength>
+struct EnumeratorDataWords<EnumeratorSummaryContainer<BitLength>>
+{
+	using DataType = EnumeratorSummaryContainer<BitLength>;
+	using WordType = typename DataType::OperandType;
+	static constexpr const size_t WORD_BITS = DataType::OPERAND_BITS;
+	static constexpr const size_t WORD_COUNT = DataType::OPERAND_COUNT;
+	
+	static inline WordType get_word(const DataType& data, size_t index)
 	{
-		return m_data != Meta::Converter::get_data(a);
+		return data.get_word(index);
 	}
 	
-	constexpr operator bool() const
+	static inline void set_word(DataType& data, size_t index, WordType word)
 	{
-		return m_data != 0;
+		data.set_word(index, word);
 	}
-	
-protected:
-	EnumType m_data;
 };
 
-template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
-class EnumeratorMask
+template <size_t BitLength>
+struct EnumeratorDataBits<EnumeratorSummaryContainer<BitLength>>
 {
-protected:
-	using Meta = EnumeratorMeta<EnumType>;
-	
-public:
-	using InnerType = EnumType;
-	static constexpr const size_t BIT_LENGTH = bit_length;
-	using DataType = typename std::conditional<
-			bit_length <= std::numeric_limits<unsigned char>::digits, unsigned char,
-			typename std::conditional<
-				bit_length <= std::numeric_limits<unsigned short int>::digits, unsigned short int,
-				typename std::conditional<
-					bit_length <= std::numeric_limits<unsigned int>::digits, unsigned int,
-					typename std::conditional<bit_length <= std::numeric_limits<unsigned long long int>::digits, unsigned long long int, EnumeratorDataContainer<bit_length>>::type
-				>::type
-			>::type
-	>::type;
+	using DataType = EnumeratorSummaryContainer<BitLength>;
+	using WordType = typename DataType::OperandType;
+	static constexpr const size_t WORD_BITS = DataType::OPERAND_BITS;
+	static constexpr const size_t NOT_FOUND = std::numeric_limits<size_t>::max();
 	
-	struct Iterator
+	static inline size_t find_next(const DataType& data, size_t bit, size_t bit_count)
 	{
-	public:
-		using iterator_category = std::input_iterator_tag;
-		using difference_type   = size_t;
-		using value_type        = EnumType;
-		using pointer           = const EnumType*;
-		using reference         = EnumType;
+		if (bit >= bit_count)
+			return NOT_FOUND;
 		
-	public:
-		constexpr Iterator(const EnumeratorMask* mask, size_t current = 1) : _mask{mask}, _current{findValue(current)}
-		{ }
+		const size_t index = bit / WORD_BITS;
+		const WordType word = data.get_word(index) & static_cast<WordType>(~static_cast<WordType>(0) << (bit % WORD_BITS));
+		size_t found = NOT_FOUND;
 		
-		constexpr reference operator*() const { return Meta::MaskConverter::get_bit(_current); }
-	
-		constexpr Iterator& operator++() { _current = findValue(_current + 1); return *this; }
-		constexpr Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+		if (word != 0)
+		{
+			found = index * WORD_BITS + EnumeratorBits::count_trailing_zeros(word);
+		}
+		else
+		{
+			const size_t next = findWord(data, index + 1);
+			
+			if (next != NOT_FOUND)
+				found = next * WORD_BITS + EnumeratorBits::count_trailing_zeros(data.get_word(next));
+		}
+		
+		return found < bit_count ? found : NOT_FOUND;
+	}
 	
-		constexpr friend bool operator== (const Iterator& a, const Iterator& b) { return a._mask == b._mask && a._current == b._current; }
-		constexpr friend bool operator!= (const Iterator& a, const Iterator& b) { return !(a == b); }
+	static inline size_t find_prev(const DataType& data, size_t bit, size_t bit_count)
+	{
+		if (bit_count == 0)
+			return NOT_FOUND;
 		
-	protected:
-		constexpr size_t findValue(size_t current) const
+		if (bit >= bit_count)
+			bit = bit_count - 1;
+		
+		size_t index = bit / WORD_BITS;
+		WordType word = data.get_word(index) & static_cast<WordType>(~static_cast<WordType>(0) >> (WORD_BITS - 1 - bit % WORD_BITS));
+		
+		if (word == 0)
 		{
-			while (!_mask->has_bit(current) && current < BIT_LENGTH)
-			{
-				++current;
-			}
+			index = findPreviousWord(data, index);
+			
+			if (index == NOT_FOUND)
+				return NOT_FOUND;
 			
-			return current;
+			word = data.get_word(index);
 		}
 		
-	private:
-		const EnumeratorMask* _mask;
-		size_t _current;
-	};
+		return index * WORD_BITS + WORD_BITS - 1 - EnumeratorBits::count_leading_zeros(word);
+	}
 	
-	struct ReverseIterator
+	static inline size_t count(const DataType& data, size_t bit_count)
+	{
+		size_t total = 0;
+		
+		for (size_t index = findWord(data, 0); index != NOT_FOUND && index * WORD_BITS < bit_count; index = findWord(data, index + 1))
+		{
+			total += EnumeratorBits::popcount(data.get_word(index) & usedBits(index, bit_count));
+		}
+		
+		return total;
+	}
+	
+	static inline size_t select(const DataType& data, size_t rank, size_t bit_count)
+	{
+		for (size_t index = findWord(data, 0); index != NOT_FOUND && index * WORD_BITS < bit_count; index = findWord(data, index + 1))
+		{
+			const WordType word = data.get_word(index) & usedBits(index, bit_count);
+			const size_t population = EnumeratorBits::popcount(word);
+			
+			if (rank < population)
+				return index * WORD_BITS + EnumeratorBits::select(word, rank);
+			
+			rank -= population;
+		}
+		
+		return NOT_FOUND;
+	}
+	
+protected:
+	// Returns the first non-zero word at or after index, NOT_FOUND if there is none
+	static inline size_t findWord(const DataType& data, size_t index)
+	{
+		if (index >= DataType::OPERAND_COUNT)
+			return NOT_FOUND;
+		
+		size_t summary_index = index / WORD_BITS;
+		WordType summary = data.get_summary(summary_index) & static_cast<WordType>(~static_cast<WordType>(0) << (index % WORD_BITS));
+		
+		while (summary == 0)
+		{
+			if (++summary_index >= DataType::SUMMARY_COUNT)
+				return NOT_FOUND;
+			
+			summary = data.get_summary(summary_index);
+		}
+		
+		return summary_index * WORD_BITS + EnumeratorBits::count_trailing_zeros(summary);
+	}
+	
+	// Returns the last non-zero word before index, NOT_FOUND if there is none
+	static inline size_t findPreviousWord(const DataType& data, size_t index)
+	{
+		if (index == 0)
+			return NOT_FOUND;
+		
+		--index;
+		size_t summary_index = index / WORD_BITS;
+		WordType summary = data.get_summary(summary_index) & static_cast<WordType>(~static_cast<WordType>(0) >> (WORD_BITS - 1 - index % WORD_BITS));
+		
+		while (summary == 0)
+		{
+			if (summary_index == 0)
+				return NOT_FOUND;
+			
+			summary = data.get_summary(--summary_index);
+		}
+		
+		return summary_index * WORD_BITS + WORD_BITS - 1 - EnumeratorBits::count_leading_zeros(summary);
+	}
+	
+	static inline WordType usedBits(size_t index, size_t bit_count)
+	{
+		const size_t remaining = bit_count - index * WORD_BITS;
+		
+		if (remaining >= WORD_BITS)
+			return static_cast<WordType>(~static_cast<WordType>(0));
+		
+		return static_cast<WordType>((static_cast<WordType>(1) << remaining) - 1);
+	}
+};
+
+// Storage of the masks of an enum, the smallest built-in type fitting bit_length if any. Specializing it selects another storage
+// for a given mask type, e.g. EnumeratorSparseContainer for masks of huge enums which only hold a few values
+template <typename EnumType, size_t bit_length>
+struct EnumeratorMaskStorage
+{
+	using type = typename std::conditional<
+			bit_length <= std::numeric_limits<unsigned char>::digits, unsigned char,
+			typename std::conditional<
+				bit_length <= std::numeric_limits<unsigned short int>::digits, unsigned short int,
+				typename std::conditional<
+					bit_length <= std::numeric_limits<unsigned int>::digits, unsigned int,
+					typename std::conditional<bit_length <= std::numeric_limits<unsigned long long int>::digits, unsigned long long int, typename EnumeratorWideDataType<bit_length>::type>::type
+				>::type
+			>::type
+	>::type;
+};
+
+
+template <typename EnumType, typename DataType, size_t bit_length, bool isFlags>
+class EnumeratorConverter
+{
+public:
+	static inline constexpr DataType get_data(EnumType value)
+	{
+		auto data_value = static_cast<typename std::make_unsigned<EnumType>::type>(value);
+		
+		if (data_value > bit_length)
+			return static_cast<DataType>(0);
+		
+		if (data_value == 0)
+			return 0;
+		
+		return static_cast<DataType>(1) << (data_value - 1);
+	}
+	
+	static inline constexpr EnumType get_value(DataType data)
+	{
+		if (data == 0)
+			return static_cast<EnumType>(0);
+		
+		DataType i=0;
+		while( !((data >> i++) & 0x01) ) { ; }
+		return static_cast<EnumType>(i);
+	}
+	
+	static inline constexpr EnumType get_bit(size_t index)
+	{
+		return static_cast<EnumType>(index);
+	}
+};
+
+template <typename EnumType, typename DataType, size_t bit_length>
+class EnumeratorConverter<EnumType, DataType, bit_length, true>
+{
+public:
+	static inline constexpr DataType get_data(EnumType value)
+	{
+		return static_cast<DataType>(value);
+	}
+	
+	static inline constexpr EnumType get_value(DataType data)
+	{
+		return static_cast<EnumType>(data);
+	}
+	
+	// index is 1-based, as for the sequential converter
+	static inline constexpr EnumType get_bit(size_t index)
+	{
+		return index != 0 ? static_cast<EnumType>(static_cast<DataType>(1) << (index - 1)) : static_cast<EnumType>(0);
+	}
+};
+
+class EnumeratorString
+{
+public:
+	static inline constexpr size_t length(const char* text)
+	{
+		if (text == nullptr)
+			return 0;
+		
+		size_t count = 0;
+		
+		while (text[count] != '\0')
+		{
+			++count;
+		}
+		
+		return count;
+	}
+	
+	static inline constexpr bool equals(const char* a, const char* b, size_t length)
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			if (a[i] != b[i])
+				return false;
+		}
+		
+		return true;
+	}
+	
+	// 64-bit FNV-1a hash, used by the name indexes. Pass the hash of the preceding bytes as result to hash data in several parts
+	static inline constexpr unsigned long long hash(const char* text, size_t length, unsigned long long result = 0xcbf29ce484222325ULL)
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			result ^= static_cast<unsigned char>(text[i]);
+			result *= 0x100000001b3ULL;
+		}
+		
+		return result;
+	}
+	
+	// Returns the position of the first occurrence of character in text, length if there is none. Scans 8 characters at a time
+	static inline size_t find(const char* text, size_t length, char character)
+	{
+		size_t position = 0;
+		
+#if defined(METAENUMERATOR_LITTLE_ENDIAN)
+		const unsigned long long pattern = 0x0101010101010101ULL * static_cast<unsigned char>(character);
+		
+		for (; position + sizeof(unsigned long long) <= length; position += sizeof(unsigned long long))
+		{
+			unsigned long long word;
+			std::memcpy(&word, text + position, sizeof(word));
+			word ^= pattern;
+			
+			// Sets the high bit of the first byte that is zero, i.e. that matched character
+			auto matches = (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+			
+			if (matches != 0)
+				return position + EnumeratorBits::count_trailing_zeros(matches) / CHAR_BIT;
+		}
+#endif
+		
+		for (; position < length; ++position)
+		{
+			if (text[position] == character)
+				return position;
+		}
+		
+		return length;
+	}
+	
+	static inline constexpr bool is_space(char character)
+	{
+		return character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == '\f' || character == '\v';
+	}
+	
+	static inline constexpr size_t next_power_of_two(size_t value)
+	{
+		size_t result = 1;
+		
+		while (result < value)
+		{
+			result <<= 1;
+		}
+		
+		return result;
+	}
+};
+
+template <typename EnumType>
+class EnumeratorMeta
+{
+};
+
+template <typename EnumType>
+class EnumeratorInherited
+{
+public:
+	using InheritedType = EnumType;
+};
+
+template<typename T, typename = void>
+struct enumerator_has_extension_meta : std::false_type { };
+template<typename T>
+struct enumerator_has_extension_meta<T, decltype((void)EnumeratorMeta<T>::enum_extension, void())> : std::true_type { };
+
+template<typename T, typename = void>
+struct enumerator_has_extension_value : std::false_type { };
+template<typename T>
+struct enumerator_has_extension_value<T, decltype((void)T::EXTENSION, void())> : std::true_type { };
+
+template<typename T>
+struct enumerator_has_extension : std::integral_constant<bool, enumerator_has_extension_meta<T>::value || enumerator_has_extension_value<T>::value> { };
+
+template<typename T, typename = void>
+struct enumerator_has_extension_arena : std::false_type { };
+template<typename T>
+struct enumerator_has_extension_arena<T, decltype((void)EnumeratorMeta<T>::extension_arena_size, void())> : std::true_type { };
+
+template<typename T, typename = void>
+struct enumerator_has_inheritance_meta : std::false_type { };
+template<typename T>
+struct enumerator_has_inheritance_meta<T, decltype((void)EnumeratorMeta<T>::enum_inheritance, void())> : std::true_type { };
+
+template<typename T, typename = void>
+struct enumerator_has_inheritance_value : std::false_type { };
+template<typename T>
+struct enumerator_has_inheritance_value<T, decltype((void)T::INHERITANCE, void())> : std::true_type { };
+
+template<typename T>
+struct enumerator_has_inheritance : std::integral_constant<bool, enumerator_has_inheritance_meta<T>::value || enumerator_has_inheritance_value<T>::value> { };
+
+template<typename T>
+struct enumerator_inherits : std::integral_constant<bool, enumerator_has_inheritance<T>::value && !std::is_same<T, typename EnumeratorInherited<T>::InheritedType>::value> { };
+
+// Whether the enum or any enum it inherits can be extended at run time
+template<typename T, bool inherits = enumerator_inherits<T>::value>
+struct enumerator_is_extendable : std::integral_constant<bool, enumerator_has_extension<T>::value> { };
+template<typename T>
+struct enumerator_is_extendable<T, true> : std::integral_constant<bool, enumerator_has_extension<T>::value || enumerator_is_extendable<typename EnumeratorInherited<T>::InheritedType>::value> { };
+
+template<typename T, typename = void>
+struct enumerator_has_name_length : std::false_type { };
+template<typename T>
+struct enumerator_has_name_length<T, decltype((void)std::declval<const T&>().get_name_length(), void())> : std::true_type { };
+
+template<typename T, typename = void>
+struct enumerator_has_base_type : std::false_type { };
+template<typename T>
+struct enumerator_has_base_type<T, decltype((void)typename EnumeratorMeta<T>::BaseEnumType(), void())> : std::true_type { };
+
+
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMask;
+
+template <typename EnumType>
+class EnumeratorNameIndex;
+
+template <typename EnumType>
+class EnumeratorValueIndex;
+
+template <size_t count>
+using EnumeratorIndexType = typename std::conditional<
+		count < std::numeric_limits<unsigned char>::max(), unsigned char,
+		typename std::conditional<count < std::numeric_limits<unsigned short int>::max(), unsigned short int, unsigned int>::type
+>::type;
+
+template <typename EnumType>
+class EnumeratorInfo
+{
+	template <typename>
+	friend class EnumeratorInfo;
+	
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using DataType = typename Meta::DataType;
+	using Extender = typename Meta::Extender;
+	using Inheritor = typename Meta::Inheritor;
+	
+public:
+	using EntryType = typename std::remove_const< typename std::remove_reference< typename std::remove_pointer< decltype(Meta::enum_entries[0]) >::type >::type >::type;
+	static constexpr const size_t ENTRY_COUNT = sizeof(EnumeratorMeta<EnumType>::enum_entries) / sizeof(EntryType);
+	
+	struct Result
+	{
+		friend class EnumeratorInfo;
+		
+	public:
+		constexpr Result() = default;
+		
+		constexpr explicit operator bool() const { return _ptr != nullptr; }
+		constexpr const EntryType& operator*() const { return *_ptr; }
+		constexpr const EntryType* operator->() { return _ptr; }
+		constexpr const EntryType* pointer() { return _ptr; }
+		
+	protected:
+		constexpr Result(const EntryType* entry) : _ptr{entry} {}
+		
+	protected:
+		const EntryType* _ptr{};
+	};
+	
+	struct Iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using difference_type   = std::ptrdiff_t;
+		using value_type        = EntryType;
+		using pointer           = const EntryType*;
+		using reference         = const EntryType&;
+		
+	public:
+		constexpr Iterator(pointer ptr) : _ptr{ptr} { }
+		
+		reference operator*() const { return *_ptr; }
+		pointer operator->() { return _ptr; }
+	
+		Iterator& operator++() { _ptr++; return *this; }  
+		Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+	
+		friend bool operator== (const Iterator& a, const Iterator& b) { return a._ptr == b._ptr; };
+		friend bool operator!= (const Iterator& a, const Iterator& b) { return a._ptr != b._ptr; };     
+		
+	private:
+		pointer _ptr;
+	};
+	
+	static constexpr Iterator cbegin() { return Iterator(EnumeratorMeta<EnumType>::enum_entries); }
+	static constexpr Iterator cend() { return Iterator(EnumeratorMeta<EnumType>::enum_entries + ENTRY_COUNT);}
+	
+	// Uses the length precomputed by the entry when available
+	template <typename T = EntryType, typename std::enable_if<enumerator_has_name_length<T>::value, int>::type = 0>
+	static constexpr size_t get_name_length(const EntryType& entry)
+	{
+		return entry.get_name_length();
+	}
+	
+	template <typename T = EntryType, typename std::enable_if<!enumerator_has_name_length<T>::value, int>::type = 0>
+	static constexpr size_t get_name_length(const EntryType& entry)
+	{
+		return EnumeratorString::length(entry.get_name());
+	}
+	
+public:
+	static constexpr Result find(EnumType value)
+	{
+		return findQuick(value);
+	}
+	
+	static constexpr Result find(const char* name)
+	{
+		if (name == nullptr)
+			return {};
+		
+		return find(name, EnumeratorString::length(name));
+	}
+	
+	// Looks up the first length characters of name, which doesn't need to be null terminated
+	static constexpr Result find(const char* name, size_t length)
+	{
+		Result result = findIndexed(name, length);
+		if (result)
+			return result;
+		result = findExtended(name, length);
+		if (result)
+			return result;
+		
+		return {};
+	}
+	
+#if defined(METAENUMERATOR_STRING_VIEW)
+	static constexpr Result find(std::string_view name)
+	{
+		return find(name.data(), name.size());
+	}
+#endif
+	
+protected:
+	// Resolves the entries of the enum and of the enums it inherits, whatever the depth of the inheritance chain
+	static constexpr Result findIndexed(EnumType value)
+	{
+		return { EnumeratorValueIndex<EnumType>::find(value) };
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr Result findQuickExtended(EnumType value)
+	{
+		auto extension = Extender::get_extension();
+		auto dataValue = static_cast<DataType>(value);
+		auto dataExtension = static_cast<DataType>(extension);
+		
+		if (dataValue >= dataExtension)
+		{
+			auto index = static_cast<size_t>(dataValue - dataExtension);
+			auto&& container = Extender::get_container();
+			
+			// Note: because of how enum extensions work, extension entries are always stored at their value's offset
+			auto entry = container.get_entry(index);
+			if (entry != nullptr && entry->get_value() == value)
+				return {entry};
+		}
+		
+		return {};
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr Result findQuickExtended(EnumType)
+	{	
+		return {};
+	}
+	
+	// Inherited enums can be extended at run time too
+	template <typename T = EnumType, typename std::enable_if<enumerator_inherits<T>::value, int>::type = 0>
+	static constexpr Result findQuickExtendedInherited(EnumType value)
+	{
+		using InheritedType = typename EnumeratorInherited<T>::InheritedType;
+		using InheritedInfo = EnumeratorInfo<InheritedType>;
+		
+		auto result = findQuickExtended(value);
+		if (result)
+			return result;
+		
+		return { InheritedInfo::findQuickExtendedInherited(static_cast<InheritedType>(value)).pointer() };
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_inherits<T>::value, int>::type = 0>
+	static constexpr Result findQuickExtendedInherited(EnumType value)
+	{
+		return findQuickExtended(value);
+	}
+	
+	static constexpr Result findQuick(EnumType value)
+	{
+		Result result = findIndexed(value);
+		if (result)
+			return result;
+		
+		// Return if the enum values aren't sequential, i.e. their values are already bitflags (isFlags parameter passed to EnumeratorMetaDefault was true)
+		if (!EnumeratorMeta<EnumType>::bitwise_conversion)
+			return {};
+		
+		return findQuickExtendedInherited(value);
+	}
+	
+	// Resolves the entries of the enum and of the enums it inherits, whatever the depth of the inheritance chain
+	static constexpr Result findIndexed(const char* name, size_t length)
+	{
+		return { EnumeratorNameIndex<EnumType>::find(name, length) };
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_inherits<T>::value, int>::type = 0>
+	static constexpr Result findExtended(const char* name, size_t length)
+	{
+		using InheritedType = typename EnumeratorInherited<T>::InheritedType;
+		using InheritedInfo = EnumeratorInfo<InheritedType>;
+		
+		auto result = findExtendedSelf(name, length);
+		if (result)
+			return result;
+		
+		return { InheritedInfo::findExtended(name, length).pointer() };
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_inherits<T>::value, int>::type = 0>
+	static constexpr Result findExtended(const char* name, size_t length)
+	{
+		return findExtendedSelf(name, length);
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr Result findExtendedSelf(const char* name, size_t length)
+	{
+		return { Extender::get_container().find_entry(name, length, EnumeratorString::hash(name, length)) };
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr Result findExtendedSelf(const char*, size_t)
+	{	
+		return {};
+	}
+};
+
+// Flattened list of the entries of an enum followed by the entries of the enums it inherits, built at compile time
+template <typename EnumType, bool inherits = enumerator_inherits<EnumType>::value>
+class EnumeratorEntryList
+{
+public:
+	using Meta = EnumeratorMeta<EnumType>;
+	using Info = EnumeratorInfo<EnumType>;
+	using EntryType = typename Info::EntryType;
+	static constexpr const size_t ENTRY_COUNT = Info::ENTRY_COUNT;
+	
+	struct Table
+	{
+		const EntryType* entries[ENTRY_COUNT]{};
+	};
+	
+	static constexpr Table build()
+	{
+		Table table{};
+		
+		for (size_t i = 0; i < Info::ENTRY_COUNT; ++i)
+		{
+			table.entries[i] = &Meta::enum_entries[i];
+		}
+		
+		return table;
+	}
+	
+	static constexpr const Table table = build();
+};
+
+template <typename EnumType>
+class EnumeratorEntryList<EnumType, true>
+{
+public:
+	using Meta = EnumeratorMeta<EnumType>;
+	using Info = EnumeratorInfo<EnumType>;
+	using EntryType = typename Info::EntryType;
+	using InheritedList = EnumeratorEntryList<typename EnumeratorInherited<EnumType>::InheritedType>;
+	static constexpr const size_t ENTRY_COUNT = Info::ENTRY_COUNT + InheritedList::ENTRY_COUNT;
+	
+	struct Table
+	{
+		const EntryType* entries[ENTRY_COUNT]{};
+	};
+	
+	static constexpr Table build()
+	{
+		Table table{};
+		
+		for (size_t i = 0; i < Info::ENTRY_COUNT; ++i)
+		{
+			table.entries[i] = &Meta::enum_entries[i];
+		}
+		
+		for (size_t i = 0; i < InheritedList::ENTRY_COUNT; ++i)
+		{
+			table.entries[Info::ENTRY_COUNT + i] = InheritedList::table.entries[i];
+		}
+		
+		return table;
+	}
+	
+	static constexpr const Table table = build();
+};
+
+template <typename EnumType, bool inherits>
+constexpr const typename EnumeratorEntryList<EnumType, inherits>::Table EnumeratorEntryList<EnumType, inherits>::table;
+
+template <typename EnumType>
+constexpr const typename EnumeratorEntryList<EnumType, true>::Table EnumeratorEntryList<EnumType, true>::table;
+
+// Hash of the names and values of the entries of an enum and of the enums it inherits, computed at compile time. Masks keep their
+// meaning between two builds with the same fingerprint, except for the values registered at run time by extensions
+template <typename EnumType>
+class EnumeratorFingerprint
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using Info = EnumeratorInfo<EnumType>;
+	using List = EnumeratorEntryList<EnumType>;
+	using DataType = typename Meta::DataType;
+	
+	static constexpr unsigned long long compute()
+	{
+		unsigned long long result = EnumeratorString::hash("", 0) ^ (Meta::bitwise_conversion ? 1 : 0);
+		
+		for (size_t i = 0; i < List::ENTRY_COUNT; ++i)
+		{
+			auto&& entry = *List::table.entries[i];
+			auto value = static_cast<unsigned long long>(static_cast<DataType>(entry.get_value()));
+			
+			for (size_t byte = 0; byte < sizeof(value); ++byte)
+			{
+				result ^= (value >> (byte * CHAR_BIT)) & 0xFF;
+				result *= 0x100000001b3ULL;
+			}
+			
+			// The terminator separates the names, "AB" "C" and "A" "BC" hash differently
+			if (entry.get_name() != nullptr)
+				result = EnumeratorString::hash(entry.get_name(), Info::get_name_length(entry) + 1, result);
+		}
+		
+		return result;
+	}
+	
+public:
+	static constexpr const unsigned long long VALUE = compute();
+};
+
+template <typename EnumType>
+constexpr const unsigned long long EnumeratorFingerprint<EnumType>::VALUE;
+
+// Open addressing hash table over the names of the entries of an enum and of the enums it inherits, built at compile time. Slots keep the upper half of the hash
+// so that a lookup usually costs one hash, one probe and one name comparison
+template <typename EnumType>
+class EnumeratorNameIndex
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using Info = EnumeratorInfo<EnumType>;
+	using EntryType = typename Info::EntryType;
+	using List = EnumeratorEntryList<EnumType>;
+	static constexpr const size_t ENTRY_COUNT = List::ENTRY_COUNT;
+	static constexpr const size_t SLOT_COUNT = EnumeratorString::next_power_of_two(ENTRY_COUNT * 2);
+	using IndexType = EnumeratorIndexType<ENTRY_COUNT>;
+	
+	struct Slot
+	{
+		unsigned int tag{};
+		IndexType index{}; // 1-based index in the entry list, 0 if the slot is empty
+	};
+	
+	struct Table
+	{
+		Slot slots[SLOT_COUNT]{};
+	};
+	
+	static constexpr Table build()
+	{
+		Table table{};
+		
+		for (size_t i = 0; i < ENTRY_COUNT; ++i)
+		{
+			auto&& entry = *List::table.entries[i];
+			
+			if (entry.get_name() == nullptr)
+				continue;
+			
+			auto hash = EnumeratorString::hash(entry.get_name(), Info::get_name_length(entry));
+			auto slot = static_cast<size_t>(hash) & (SLOT_COUNT - 1);
+			
+			while (table.slots[slot].index != 0)
+			{
+				slot = (slot + 1) & (SLOT_COUNT - 1);
+			}
+			
+			table.slots[slot].tag = static_cast<unsigned int>(hash >> 32);
+			table.slots[slot].index = static_cast<IndexType>(i + 1);
+		}
+		
+		return table;
+	}
+	
+	static constexpr const Table table = build();
+	
+public:
+	static constexpr const EntryType* find(const char* name, size_t length)
+	{
+		auto hash = EnumeratorString::hash(name, length);
+		auto tag = static_cast<unsigned int>(hash >> 32);
+		auto slot = static_cast<size_t>(hash) & (SLOT_COUNT - 1);
+		
+		while (table.slots[slot].index != 0)
+		{
+			if (table.slots[slot].tag == tag)
+			{
+				auto&& entry = *List::table.entries[table.slots[slot].index - 1];
+				
+				if (Info::get_name_length(entry) == length && EnumeratorString::equals(entry.get_name(), name, length))
+					return &entry;
+			}
+			
+			slot = (slot + 1) & (SLOT_COUNT - 1);
+		}
+		
+		return nullptr;
+	}
+};
+
+template <typename EnumType>
+constexpr const typename EnumeratorNameIndex<EnumType>::Table EnumeratorNameIndex<EnumType>::table;
+
+// Table mapping the values of the entries of an enum and of the enums it inherits to their entry, built at compile time. Sequential values are mapped through their offset
+// from the smallest value and flag values through the position of their bit, in both cases regardless of the declaration order.
+// Enums whose values are too sparse for a direct table use an open addressing hash table instead
+template <typename EnumType>
+class EnumeratorValueIndex
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using Info = EnumeratorInfo<EnumType>;
+	using EntryType = typename Info::EntryType;
+	using DataType = typename Meta::DataType;
+	using UnsignedType = typename std::make_unsigned<DataType>::type;
+	using List = EnumeratorEntryList<EnumType>;
+	static constexpr const size_t ENTRY_COUNT = List::ENTRY_COUNT;
+	using IndexType = EnumeratorIndexType<ENTRY_COUNT>;
+	
+	static constexpr DataType getData(const EntryType& entry)
+	{
+		return static_cast<DataType>(entry.get_value());
+	}
+	
+	static constexpr bool hasFlagKeys()
+	{
+		if (Meta::bitwise_conversion)
+			return false;
+		
+		for (size_t i = 0; i < ENTRY_COUNT; ++i)
+		{
+			auto data = static_cast<UnsignedType>(getData(*List::table.entries[i]));
+			
+			if ((data & (data - 1)) != 0)
+				return false;
+		}
+		
+		return true;
+	}
+	
+	static constexpr DataType getMinimum()
+	{
+		DataType minimum = getData(*List::table.entries[0]);
+		
+		for (size_t i = 1; i < ENTRY_COUNT; ++i)
+		{
+			if (getData(*List::table.entries[i]) < minimum)
+				minimum = getData(*List::table.entries[i]);
+		}
+		
+		return minimum;
+	}
+	
+	static constexpr UnsignedType getRange()
+	{
+		UnsignedType range = 0;
+		
+		for (size_t i = 0; i < ENTRY_COUNT; ++i)
+		{
+			auto offset = static_cast<UnsignedType>(static_cast<UnsignedType>(getData(*List::table.entries[i])) - static_cast<UnsignedType>(MINIMUM));
+			
+			if (offset > range)
+				range = offset;
+		}
+		
+		return range;
+	}
+	
+	static constexpr const bool FLAG_KEYS = hasFlagKeys();
+	static constexpr const DataType MINIMUM = getMinimum();
+	static constexpr const size_t DENSE_LIMIT = ENTRY_COUNT * 8 + 256;
+	static constexpr const bool DENSE = FLAG_KEYS || getRange() < DENSE_LIMIT;
+	static constexpr const size_t SLOT_COUNT = FLAG_KEYS ? std::numeric_limits<UnsignedType>::digits + 1 :
+		(DENSE ? static_cast<size_t>(getRange()) + 1 : EnumeratorString::next_power_of_two(ENTRY_COUNT * 2));
+	
+	static constexpr size_t getSlot(DataType data)
+	{
+		if (FLAG_KEYS)
+		{
+			auto bits = static_cast<UnsignedType>(data);
+			return bits != 0 ? EnumeratorBits::count_trailing_zeros(bits) + 1 : 0;
+		}
+		
+		if (DENSE)
+			return static_cast<size_t>(static_cast<UnsignedType>(static_cast<UnsignedType>(data) - static_cast<UnsignedType>(MINIMUM)));
+		
+		auto hash = static_cast<unsigned long long>(static_cast<UnsignedType>(data)) * 0x9E3779B97F4A7C15ULL;
+		return static_cast<size_t>(hash >> 32) & (SLOT_COUNT - 1);
+	}
+	
+	struct Table
+	{
+		IndexType slots[SLOT_COUNT]{}; // 1-based index in the entry list, 0 if the slot is empty
+	};
+	
+	static constexpr Table build()
+	{
+		Table table{};
+		
+		for (size_t i = 0; i < ENTRY_COUNT; ++i)
+		{
+			auto data = getData(*List::table.entries[i]);
+			auto slot = getSlot(data);
+			
+			if (DENSE)
+			{
+				// Keep the first entry declared with a value
+				if (table.slots[slot] == 0)
+					table.slots[slot] = static_cast<IndexType>(i + 1);
+				
+				continue;
+			}
+			
+			while (table.slots[slot] != 0 && getData(*List::table.entries[table.slots[slot] - 1]) != data)
+			{
+				slot = (slot + 1) & (SLOT_COUNT - 1);
+			}
+			
+			if (table.slots[slot] == 0)
+				table.slots[slot] = static_cast<IndexType>(i + 1);
+		}
+		
+		return table;
+	}
+	
+	static constexpr const Table table = build();
+	
+public:
+	static constexpr const EntryType* find(EnumType value)
+	{
+		auto data = static_cast<DataType>(value);
+		auto slot = getSlot(data);
+		
+		if (DENSE)
+		{
+			if (slot >= SLOT_COUNT || table.slots[slot] == 0)
+				return nullptr;
+			
+			auto&& entry = *List::table.entries[table.slots[slot] - 1];
+			return getData(entry) == data ? &entry : nullptr;
+		}
+		
+		while (table.slots[slot] != 0)
+		{
+			auto&& entry = *List::table.entries[table.slots[slot] - 1];
+			
+			if (getData(entry) == data)
+				return &entry;
+			
+			slot = (slot + 1) & (SLOT_COUNT - 1);
+		}
+		
+		return nullptr;
+	}
+};
+
+template <typename EnumType>
+constexpr const typename EnumeratorValueIndex<EnumType>::Table EnumeratorValueIndex<EnumType>::table;
+
+template <typename MaskType>
+struct EnumeratorMaskParseResult
+{
+	MaskType mask{};
+	size_t error_position{}; // Offset of the first character of the token which failed to parse, only meaningful on failure
+	bool success{};
+	
+	constexpr explicit operator bool() const { return success; }
+};
+
+template <typename EnumType>
+class EnumeratorSerializer
+{
+	using Info = EnumeratorInfo<EnumType>;
+	using EntryType = typename Info::EntryType;
+	
+public:
+	static constexpr decltype(std::declval<EntryType>().get_name()) get_name(EnumType value)
+	{
+		auto it = Info::find(value);
+		
+		if (it)
+			return it->get_name();
+		
+		return nullptr;
+	}
+	
+	static constexpr decltype(std::declval<EntryType>().get_label()) get_label(EnumType value)
+	{
+		auto it = Info::find(value);
+		
+		if (it)
+			return it->get_label();
+		
+		return nullptr;
+	}
+	
+	static constexpr EnumType get_value(const char* name)
+	{
+		auto it = Info::find(name);
+		
+		if (it)
+			return it->get_value();
+		
+		return EnumeratorMeta<EnumType>::Converter::get_value(0);
+	}
+	
+	// Looks up the first length characters of name, which doesn't need to be null terminated
+	static constexpr EnumType get_value(const char* name, size_t length)
+	{
+		auto it = Info::find(name, length);
+		
+		if (it)
+			return it->get_value();
+		
+		return EnumeratorMeta<EnumType>::Converter::get_value(0);
+	}
+	
+#if defined(METAENUMERATOR_STRING_VIEW)
+	static constexpr EnumType get_value(std::string_view name)
+	{
+		return get_value(name.data(), name.size());
+	}
+#endif
+	
+	// Parses a list of names separated by commas, e.g. "ENEMY_ALIVE, ALLY_ALIVE" as printed for masks. Whitespace around names is ignored
+	template <typename MaskType = typename EnumeratorMeta<EnumType>::MaskType>
+	static EnumeratorMaskParseResult<MaskType> parse_mask(const char* text, size_t length)
+	{
+		EnumeratorMaskParseResult<MaskType> result{};
+		result.success = parse_mask(text, length, result.mask, &result.error_position);
+		
+		return result;
+	}
+	
+#if defined(METAENUMERATOR_STRING_VIEW)
+	template <typename MaskType = typename EnumeratorMeta<EnumType>::MaskType>
+	static EnumeratorMaskParseResult<MaskType> parse_mask(std::string_view text)
+	{
+		return parse_mask<MaskType>(text.data(), text.size());
+	}
+#endif
+	
+	// ORs the values listed in text into mask. On failure returns false and sets error_position to the offset of the first token which
+	// isn't a known name, the values before it have already been added to mask
+	template <size_t bit_length>
+	static bool parse_mask(const char* text, size_t length, EnumeratorMask<EnumType, bit_length>& mask, size_t* error_position = nullptr)
+	{
+		size_t position = 0;
+		
+		while (position < length && EnumeratorString::is_space(text[position]))
+		{
+			++position;
+		}
+		
+		// An empty list is a valid, empty mask
+		if (position == length)
+			return true;
+		
+		while (true)
+		{
+			const size_t start = position;
+			const size_t separator = start + EnumeratorString::find(text + start, length - start, ',');
+			size_t end = separator;
+			
+			while (end > start && EnumeratorString::is_space(text[end - 1]))
+			{
+				--end;
+			}
+			
+			auto it = Info::find(text + start, end - start);
+			
+			if (!it)
+			{
+				if (error_position != nullptr)
+					*error_position = start;
+				
+				return false;
+			}
+			
+			mask |= (*it).get_value();
+			
+			if (separator == length)
+				return true;
+			
+			position = separator + 1;
+			
+			while (position < length && EnumeratorString::is_space(text[position]))
+			{
+				++position;
+			}
+		}
+	}
+};
+
+// Append-only string storage, strings can be interned concurrently
+template <size_t Size>
+class EnumeratorStringArena
+{
+public:
+	// Copies length characters of text followed by a null terminator, returns nullptr if the arena is full
+	const char* intern(const char* text, size_t length)
+	{
+		auto offset = _used.fetch_add(length + 1, std::memory_order_relaxed);
+		
+		if (offset + length + 1 > Size)
+			return nullptr;
+		
+		std::memcpy(_data + offset, text, length);
+		_data[offset + length] = '\0';
+		
+		return _data + offset;
+	}
+	
+	size_t get_size() const
+	{
+		auto used = _used.load(std::memory_order_relaxed);
+		return used < Size ? used : Size;
+	}
+	
+protected:
+	char _data[Size];
+	std::atomic<size_t> _used{};
+};
+
+template <>
+class EnumeratorStringArena<0>
+{
+public:
+	const char* intern(const char*, size_t)
+	{
+		return nullptr;
+	}
+	
+	size_t get_size() const
+	{
+		return 0;
+	}
+};
+
+// Read-only access to whole files, memory mapped on POSIX systems and read into memory otherwise
+class EnumeratorFile
+{
+public:
+	// Returns the content of path and sets size, nullptr if the file can't be read or is empty
+	static const void* map(const char* path, size_t& size)
+	{
+#if defined(METAENUMERATOR_MMAP)
+		int descriptor = ::open(path, O_RDONLY);
+		
+		if (descriptor < 0)
+			return nullptr;
+		
+		struct stat status;
+		void* data = nullptr;
+		
+		if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+		{
+			size = static_cast<size_t>(status.st_size);
+			data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			
+			if (data == MAP_FAILED)
+				data = nullptr;
+		}
+		
+		::close(descriptor);
+		return data;
+#else
+		auto file = std::fopen(path, "rb");
+		
+		if (file == nullptr)
+			return nullptr;
+		
+		char* data = nullptr;
+		
+		if (std::fseek(file, 0, SEEK_END) == 0)
+		{
+			auto length = std::ftell(file);
+			
+			if (length > 0 && std::fseek(file, 0, SEEK_SET) == 0)
+			{
+				size = static_cast<size_t>(length);
+				data = new char[size];
+				
+				if (std::fread(data, size, 1, file) != 1)
+				{
+					delete[] data;
+					data = nullptr;
+				}
+			}
+		}
+		
+		std::fclose(file);
+		return data;
+#endif
+	}
+	
+	static void unmap(const void* data, size_t size)
+	{
+#if defined(METAENUMERATOR_MMAP)
+		::munmap(const_cast<void*>(data), size);
+#else
+		(void)size;
+		delete[] static_cast<const char*>(data);
+#endif
+	}
+};
+
+template <typename EnumType>
+class EnumeratorExtender
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using Info = EnumeratorInfo<EnumType>;
+	using EntryType = typename Info::EntryType;
+	using DataType = typename Meta::DataType;
+	static constexpr const DataType max_enum_value = static_cast<DataType>(Meta::MAX_VALUE);
+	
+public:
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr bool has_extension()
+	{
+		return true;
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr bool has_extension()
+	{
+		return false;
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension_meta<T>::value, int>::type = 0>
+	static constexpr T get_extension()
+	{
+		return static_cast<T>(Meta::enum_extension);
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension_value<T>::value && !enumerator_has_extension_meta<T>::value, int>::type = 0>
+	static constexpr T get_extension()
+	{
+		return static_cast<T>(EnumType::EXTENSION);
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr EnumType get_extension()
+	{
+		static_assert(sizeof(T) == 0, "EnumeratorExtender requires the EnumeratorMeta to define an enum_extension variable or the enum to contain an EXTENSION value.");
+	}
+	
+	// Opting-in by defining extension_arena_size in the EnumeratorMeta makes extend() copy names and labels into an arena owned
+	// by the extension container, so that callers don't need to keep them alive
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension_arena<T>::value, int>::type = 0>
+	static constexpr size_t get_arena_size()
+	{
+		return Meta::extension_arena_size;
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension_arena<T>::value, int>::type = 0>
+	static constexpr size_t get_arena_size()
+	{
+		return 0;
+	}
+	
+	// Extensions can be registered concurrently with lookups: writers reserve a slot atomically and publish the entry once written,
+	// readers never wait and ignore slots which are reserved but not published yet
+	// Names are indexed by an open addressing table whose slots hold the entry index + 1, filled right before the entry is published
+	template<EnumType extension>
+	struct Container
+	{
+		static constexpr const size_t ENTRY_COUNT = max_enum_value - static_cast<DataType>(extension) + 1;
+		static constexpr const size_t ARENA_SIZE = get_arena_size();
+		static constexpr const size_t INDEX_SIZE = EnumeratorString::next_power_of_two(ENTRY_COUNT * 2);
+		
+		EntryType enum_entries[ENTRY_COUNT]{};
+		unsigned long long enum_hashes[ENTRY_COUNT]{};
+		std::atomic<bool> enum_published[ENTRY_COUNT]{};
+		std::atomic<size_t> enum_reserved{};
+		std::atomic<size_t> enum_index[INDEX_SIZE]{};
+		EnumeratorStringArena<ARENA_SIZE> enum_arena{};
+		
+		// Returns the amount of reserved slots, some of which might not be published yet
+		size_t get_size() const
+		{
+			auto reserved = enum_reserved.load(std::memory_order_acquire);
+			return reserved < ENTRY_COUNT ? reserved : ENTRY_COUNT;
+		}
+		
+		// Returns the entry at index, nullptr if it isn't published
+		const EntryType* get_entry(size_t index) const
+		{
+			if (index < ENTRY_COUNT && enum_published[index].load(std::memory_order_acquire))
+				return &enum_entries[index];
+			
+			return nullptr;
+		}
+		
+		// Returns the first indexed entry with the given name, nullptr if there's none
+		const EntryType* find_entry(const char* name, size_t length, unsigned long long hash) const
+		{
+			for (size_t i = 0; i < INDEX_SIZE; ++i)
+			{
+				auto slot = enum_index[(hash + i) & (INDEX_SIZE - 1)].load(std::memory_order_acquire);
+				
+				if (slot == 0)
+					return nullptr;
+				
+				auto entry = get_entry(slot - 1);
+				
+				if (entry != nullptr && enum_hashes[slot - 1] == hash && Info::get_name_length(*entry) == length && EnumeratorString::equals(entry->get_name(), name, length))
+					return entry;
+			}
+			
+			return nullptr;
+		}
+		
+		// Adds the entry at index to the name index, the table has twice the entries so there's always a free slot
+		void insert_entry(size_t index)
+		{
+			auto hash = enum_hashes[index];
+			
+			for (size_t i = 0; i < INDEX_SIZE; ++i)
+			{
+				size_t expected = 0;
+				
+				if (enum_index[(hash + i) & (INDEX_SIZE - 1)].compare_exchange_strong(expected, index + 1, std::memory_order_release, std::memory_order_relaxed))
+					return;
+			}
+		}
+	};
+	
+	// Making this a templated function is an unfortunately required hack to build on MSVC
+	template<EnumType extension = get_extension()>
+	static Container<extension>& get_container()
+	{
+		static_assert (extension == get_extension(), "Do not pass a template parameter to this function, read comment above.");
+		static Container<extension> container{};
+		return container;
+	}
+	
+	template <typename... Types>
+	static EnumType extend(Types... entries)
+	{
+		auto&& container = get_container<get_extension()>();
+		bool interned = true;
+		
+		return extendInterned(container, interned, intern(container, entries, interned)...);
+	}
+	
+	// Writes the published extensions (values, names and labels) to path, so that load() can restore them with the same values
+	static bool save(const char* path)
+	{
+		auto&& container = get_container<get_extension()>();
+		auto size = container.get_size();
+		size_t count = 0;
+		uint64_t blob_size = 0;
+		
+		// Only the leading published entries are saved, as values must stay sequential
+		for (; count < size && container.get_entry(count) != nullptr; ++count)
+		{
+			auto&& entry = container.enum_entries[count];
+			blob_size += getStoredSize(entry.get_name()) + getStoredSize(entry.get_label());
+		}
+		
+		if (blob_size >= FILE_NONE)
+			return false;
+		
+		auto file = std::fopen(path, "wb");
+		
+		if (file == nullptr)
+			return false;
+		
+		FileHeader header{FILE_MAGIC, FILE_VERSION, static_cast<int64_t>(static_cast<DataType>(get_extension())), count, blob_size};
+		bool success = std::fwrite(&header, sizeof(header), 1, file) == 1;
+		uint32_t offset = 0;
+		
+		for (size_t i = 0; i < count && success; ++i)
+		{
+			auto&& entry = container.enum_entries[i];
+			FileRecord record{container.enum_hashes[i], FILE_NONE, 0, FILE_NONE, 0};
+			
+			if (entry.get_name() != nullptr)
+			{
+				record.name_offset = offset;
+				record.name_length = static_cast<uint32_t>(Info::get_name_length(entry));
+				offset += record.name_length + 1;
+			}
+			
+			if (entry.get_label() != nullptr)
+			{
+				record.label_offset = offset;
+				record.label_length = static_cast<uint32_t>(EnumeratorString::length(entry.get_label()));
+				offset += record.label_length + 1;
+			}
+			
+			success = std::fwrite(&record, sizeof(record), 1, file) == 1;
+		}
+		
+		for (size_t i = 0; i < count && success; ++i)
+		{
+			auto&& entry = container.enum_entries[i];
+			success = writeString(file, entry.get_name()) && writeString(file, entry.get_label());
+		}
+		
+		return std::fclose(file) == 0 && success;
+	}
+	
+	// Restores the extensions written by save(), failing if any extension was registered already
+	// The file stays mapped (or loaded) for the lifetime of the process, as the restored entries point to its strings
+	static bool load(const char* path)
+	{
+		size_t size = 0;
+		auto data = static_cast<const char*>(EnumeratorFile::map(path, size));
+		
+		if (data == nullptr)
+			return false;
+		
+		auto&& container = get_container<get_extension()>();
+		FileHeader header{};
+		
+		if (!validateFile(data, size, header, container.ENTRY_COUNT))
+		{
+			EnumeratorFile::unmap(data, size);
+			return false;
+		}
+		
+		auto count = static_cast<size_t>(header.entry_count);
+		size_t expected = 0;
+		
+		if (!container.enum_reserved.compare_exchange_strong(expected, count, std::memory_order_relaxed))
+		{
+			EnumeratorFile::unmap(data, size);
+			return false;
+		}
+		
+		auto blob = data + sizeof(FileHeader) + count * sizeof(FileRecord);
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			FileRecord record;
+			std::memcpy(&record, data + sizeof(FileHeader) + i * sizeof(FileRecord), sizeof(record));
+			
+			auto value = static_cast<EnumType>(static_cast<DataType>(get_extension()) + static_cast<DataType>(i));
+			auto name = record.name_offset != FILE_NONE ? blob + record.name_offset : nullptr;
+			auto label = record.label_offset != FILE_NONE ? blob + record.label_offset : nullptr;
+			container.enum_entries[i] = EntryType{value, name, label};
+			
+			if (name != nullptr)
+			{
+				container.enum_hashes[i] = record.hash;
+				container.insert_entry(i);
+			}
+			
+			container.enum_published[i].store(true, std::memory_order_release);
+		}
+		
+		return true;
+	}
+	
+protected:
+	static constexpr const uint32_t FILE_MAGIC = 0x5845454D; // "MEEX" when stored in little endian
+	static constexpr const uint32_t FILE_VERSION = 1;
+	static constexpr const uint32_t FILE_NONE = 0xFFFFFFFF;
+	
+	// A file is made of the header, one record per entry and the null terminated strings the records point to
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		int64_t extension;
+		uint64_t entry_count;
+		uint64_t blob_size;
+	};
+	
+	struct FileRecord
+	{
+		uint64_t hash;
+		uint32_t name_offset;
+		uint32_t name_length;
+		uint32_t label_offset;
+		uint32_t label_length;
+	};
+	
+	static uint64_t getStoredSize(const char* text)
+	{
+		return text != nullptr ? EnumeratorString::length(text) + 1 : 0;
+	}
+	
+	static bool writeString(std::FILE* file, const char* text)
+	{
+		return text == nullptr || std::fwrite(text, EnumeratorString::length(text) + 1, 1, file) == 1;
+	}
+	
+	static bool validateString(const char* blob, uint64_t blob_size, uint32_t offset, uint32_t length)
+	{
+		if (offset == FILE_NONE)
+			return true;
+		
+		return static_cast<uint64_t>(offset) + length < blob_size && blob[offset + length] == '\0' && EnumeratorString::length(blob + offset) == length;
+	}
+	
+	static bool validateFile(const char* data, size_t size, FileHeader& header, size_t entry_count)
+	{
+		if (size < sizeof(FileHeader))
+			return false;
+		
+		std::memcpy(&header, data, sizeof(header));
+		
+		if (header.magic != FILE_MAGIC || header.version != FILE_VERSION || header.extension != static_cast<int64_t>(static_cast<DataType>(get_extension())))
+			return false;
+		
+		if (header.entry_count > entry_count)
+			return false;
+		
+		auto records_size = header.entry_count * sizeof(FileRecord);
+		
+		if (size - sizeof(FileHeader) < records_size || header.blob_size != size - sizeof(FileHeader) - records_size)
+			return false;
+		
+		auto blob = data + sizeof(FileHeader) + records_size;
+		
+		for (size_t i = 0; i < header.entry_count; ++i)
+		{
+			FileRecord record;
+			std::memcpy(&record, data + sizeof(FileHeader) + i * sizeof(FileRecord), sizeof(record));
+			
+			if (!validateString(blob, header.blob_size, record.name_offset, record.name_length) || !validateString(blob, header.blob_size, record.label_offset, record.label_length))
+				return false;
+		}
+		
+		return true;
+	}
+	
+	// interned is taken by reference and only read here, once every intern() call made for the arguments has completed
+	template <typename ContainerType, typename... Types>
+	static EnumType extendInterned(ContainerType& container, const bool& interned, Types... entries)
+	{
+		if (!interned)
+			return static_cast<EnumType>(0);
+		
+		auto entry_index = container.enum_reserved.fetch_add(1, std::memory_order_relaxed);
+		
+		if (entry_index < container.ENTRY_COUNT)
+		{
+			auto return_enum = static_cast<EnumType>(static_cast<DataType>(get_extension()) + static_cast<DataType>(entry_index));
+			auto&& entry = container.enum_entries[entry_index];
+			entry = EntryType{return_enum, entries...};
+			
+			if (entry.get_name() != nullptr)
+			{
+				container.enum_hashes[entry_index] = EnumeratorString::hash(entry.get_name(), Info::get_name_length(entry));
+				container.insert_entry(entry_index);
+			}
+			
+			container.enum_published[entry_index].store(true, std::memory_order_release);
+			
+			return return_enum;
+		}
+		
+		// This is not ideal, if extensions overflow we should throw? or at least assert?
+		return static_cast<EnumType>(0);
+	}
+	
+	template <typename ContainerType>
+	static const char* intern(ContainerType& container, const char* text, bool& interned)
+	{
+		if (ContainerType::ARENA_SIZE == 0 || text == nullptr)
+			return text;
+		
+		auto copy = container.enum_arena.intern(text, EnumeratorString::length(text));
+		
+		if (copy == nullptr)
+			interned = false;
+		
+		return copy;
+	}
+	
+	template <typename ContainerType, typename T, typename std::enable_if<!std::is_convertible<T, const char*>::value, int>::type = 0>
+	static T intern(ContainerType&, T value, bool&)
+	{
+		return value;
+	}
+};
+
+template <typename EnumType>
+class EnumeratorInheritor
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using DataType = typename Meta::DataType;
+	static constexpr const DataType max_enum_value = static_cast<DataType>(Meta::MAX_VALUE);
+	
+public:
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance<T>::value, int>::type = 0>
+	static constexpr bool has_inheritance()
+	{
+		return true;
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_inheritance<T>::value, int>::type = 0>
+	static constexpr bool has_inheritance()
+	{
+		return false;
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance_meta<T>::value, int>::type = 0>
+	static constexpr T get_inheritance()
+	{
+		return static_cast<T>(Meta::enum_inheritance);
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_inheritance_value<T>::value && !enumerator_has_inheritance_meta<T>::value, int>::type = 0>
+	static constexpr T get_inheritance()
+	{
+		return static_cast<T>(EnumType::INHERITANCE);
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_inheritance<T>::value, int>::type = 0>
+	static constexpr EnumType get_enum_inheritance()
+	{
+		static_assert(sizeof(T) == 0, "EnumeratorInheritor requires the EnumeratorMeta to define an enum_inheritance variable or the enum to contain an INHERITANCE value.");
+	}
+	
+	static constexpr DataType inherit()
+	{
+		return static_cast<DataType>(get_inheritance());
+	}
+	
+	static constexpr DataType inheritMaximum()
+	{
+		return max_enum_value;
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr DataType inheritExtension()
+	{
+		return static_cast<DataType>(Meta::Extender::get_extension());
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
+	static constexpr DataType inheritExtension()
+	{
+		return inheritMaximum();
+	}
+};
+
+template <typename EnumType>
+class EnumeratorSpecializer
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using DataType = typename Meta::DataType;
+	
+public:
+	template <typename T = EnumType, typename std::enable_if<enumerator_has_base_type<T>::value, int>::type = 0>
+	static constexpr bool has_base()
+	{
+		return true;
+	}
+	
+	template <typename T = EnumType, typename std::enable_if<!enumerator_has_base_type<T>::value, int>::type = 0>
+	static constexpr bool has_base()
+	{
+		return false;
+	}
+};
+
+template <typename EnumType_>
+class SmartEnumerator
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType_>;
+	
+public:
+	using EnumType = EnumType_;
+	using DataType = typename Meta::DataType;
+	
+public:
+	constexpr SmartEnumerator(EnumType value) : m_data(value) { }
+	
+	template<typename EnumT, typename std::enable_if<std::is_enum<EnumT>::value && (std::is_same<EnumT, typename Meta::BaseEnumType>::value || std::is_same<EnumType, typename EnumeratorMeta<EnumT>::BaseEnumType>::value), int>::type = 0>
+	constexpr SmartEnumerator(EnumT value) : SmartEnumerator(static_cast<DataType>(value)) { }
+	
+protected:
+	constexpr SmartEnumerator(DataType data) : m_data(static_cast<EnumType>(data)) { }
+	
+public:
+	constexpr DataType data() const
+	{
+		return m_data;
+	}
+	
+	constexpr bool operator==(SmartEnumerator a) const
+	{
+		return m_data == a.m_data;
+	}
+	
+	constexpr bool operator==(EnumType a) const
+	{
+		return m_data == Meta::Converter::get_data(a);
+	}
+	
+	constexpr bool operator!=(SmartEnumerator a) const
+	{
+		return m_data != a.m_data;
+	}
+	
+	constexpr bool operator!=(EnumType a) const
+	{
+		return m_data != Meta::Converter::get_data(a);
+	}
+	
+	constexpr operator bool() const
+	{
+		return m_data != 0;
+	}
+	
+protected:
+	EnumType m_data;
+};
+
+template <typename EnumType, size_t bit_length>
+class EnumeratorMask
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	
+public:
+	using InnerType = EnumType;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	using DataType = typename EnumeratorMaskStorage<EnumType, bit_length>::type;
+	
+protected:
+	using Bits = EnumeratorDataBits<DataType>;
+	
+public:
+	struct Iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using difference_type   = size_t;
+		using value_type        = EnumType;
+		using pointer           = const EnumType*;
+		using reference         = EnumType;
+		
+	public:
+		constexpr Iterator(const EnumeratorMask* mask, size_t current = 1) : _mask{mask}, _current{findValue(mask, current)}
+		{ }
+		
+		constexpr reference operator*() const { return Meta::MaskConverter::get_bit(_current); }
+	
+		constexpr Iterator& operator++() { _current = _mask->find_next(_current); return *this; }
+		constexpr Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+	
+		constexpr friend bool operator== (const Iterator& a, const Iterator& b) { return a._mask == b._mask && a._current == b._current; }
+		constexpr friend bool operator!= (const Iterator& a, const Iterator& b) { return !(a == b); }
+		
+	protected:
+		static constexpr size_t findValue(const EnumeratorMask* mask, size_t current)
+		{
+			return mask->find_next(current > 0 ? current - 1 : 0);
+		}
+		
+	private:
+		const EnumeratorMask* _mask;
+		size_t _current;
+	};
+	
+	struct ReverseIterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using difference_type   = size_t;
+		using value_type        = EnumType;
+		using pointer           = const EnumType*;
+		using reference         = EnumType;
+		
+	public:
+		constexpr ReverseIterator(const EnumeratorMask* mask, size_t current = BIT_LENGTH) : _mask{mask}, _current{mask->find_prev(current + 1)}
+		{ }
+		
+		constexpr reference operator*() const { return Meta::MaskConverter::get_bit(_current); }
+	
+		constexpr ReverseIterator& operator++() { _current = _mask->find_prev(_current); return *this; }
+		constexpr ReverseIterator operator++(int) { ReverseIterator tmp = *this; ++(*this); return tmp; }
+	
+		constexpr friend bool operator== (const ReverseIterator& a, const ReverseIterator& b) { return a._mask == b._mask && a._current == b._current; }
+		constexpr friend bool operator!= (const ReverseIterator& a, const ReverseIterator& b) { return !(a == b); }
+		
+	private:
+		const EnumeratorMask* _mask;
+		size_t _current;
+	};
+	
+	// Note: std::is_scalar and std::numeric_limits aren't specialized for 128-bit integers in strict ISO mode
+	template <typename T = DataType, typename std::enable_if<!std::is_class<T>::value, int>::type = 0>
+	static inline constexpr EnumeratorMask all()
+	{
+		static_assert(sizeof(T) <= sizeof(DataType), "EnumeratorMask: T must fit inside DataType");
+		return EnumeratorMask(static_cast<DataType>(static_cast<T>(~static_cast<T>(0))));
+	}
+	
+	template <typename T = DataType, typename std::enable_if<std::is_class<T>::value, int>::type = 0>
+	static inline constexpr EnumeratorMask all()
+	{
+		static_assert(sizeof(T) <= sizeof(DataType), "EnumeratorMask: T must fit inside DataType");
+		return EnumeratorMask(T::max());
+	}
+	
+public:
+	constexpr EnumeratorMask() noexcept : m_data{}
+	{	}
+	constexpr EnumeratorMask(const EnumeratorMask& other) noexcept = default;
+	constexpr EnumeratorMask(EnumType value) noexcept : m_data(Meta::MaskConverter::get_data(value)) 
+	{
+		static_assert(
+			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
+			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
+		);
+	}
+	constexpr explicit EnumeratorMask(DataType data) noexcept : m_data(data)
+	{	}
+	
+public:
+	constexpr DataType data() const
+	{
+		return m_data;
+	}
+	
+	constexpr bool operator==(const EnumeratorMask& a) const
+	{
+		return m_data == a.m_data;
+	}
+	
+	constexpr bool operator==(EnumType a) const
+	{
+		return m_data == Meta::MaskConverter::get_data(a);
+	}
+	
+	constexpr bool operator!=(const EnumeratorMask& a) const
+	{
+		return m_data != a.m_data;
+	}
+	
+	constexpr bool operator!=(EnumType a) const
+	{
+		return m_data != Meta::MaskConverter::get_data(a);
+	}
+	
+	constexpr bool is_empty() const
+	{
+		return m_data == 0;
+	}
+	
+	constexpr bool has(EnumType bit) const
+	{
+		static_assert(
+			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
+			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
+		);
+		
+		auto val = Meta::MaskConverter::get_data(bit);
+		return (m_data & val) == val;
+	}
+	
+	constexpr bool has(EnumeratorMask mask) const
+	{
+		return (m_data & mask.m_data) == mask.m_data;
+	}
+	
+	constexpr bool has(DataType data) const
+	{
+		return (m_data & data) == data;
+	}
+	
+	constexpr bool has_any(EnumeratorMask mask) const
+	{
+		return (m_data & mask.m_data) != 0;
+	}
+	
+	constexpr bool has_any(DataType data) const
+	{
+		return (m_data & data) != 0;
+	}
+	
+	// Values are cleared by removing their intersection, complementing them would be costly for sparse storages
+	constexpr void set(EnumType bit, bool value)
+	{
+		static_assert(
+			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
+			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
+		);
+		
+		auto val = Meta::MaskConverter::get_data(bit);
+		if (value)
+			m_data |= val;
+		else
+			m_data ^= m_data & val;
+	}
+	
+	constexpr void set(EnumeratorMask mask, bool value)
+	{
+		if (value)
+			m_data |= mask.m_data;
+		else
+			m_data ^= m_data & mask.m_data;
+	}
+	
+	constexpr void set(DataType data, bool value)
+	{
+		if (value)
+			m_data |= data;
+		else
+			m_data ^= m_data & data;
+	}
+	
+	constexpr void clear()
+	{
+		m_data = 0;
+	}
+
+	constexpr EnumeratorMask operator|(EnumType a) const
+	{
+		static_assert(
+			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
+			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
+		);
+		
+		auto data = Meta::MaskConverter::get_data(a);
+		EnumeratorMask m(m_data | data);
+		return m;
+	}
+	
+	constexpr EnumeratorMask operator|(EnumeratorMask a) const
+	{
+		EnumeratorMask m(m_data | a.m_data);
+		return m;
+	}
+	
+	constexpr EnumeratorMask operator|=(EnumType a)
+	{
+		static_assert(
+			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
+			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
+		);
+		
+		m_data = m_data | Meta::MaskConverter::get_data(a);
+		return *this;
+	}
+	
+	constexpr EnumeratorMask operator|=(EnumeratorMask a)
+	{ 
+		m_data = m_data | a.m_data;
+		return *this;
+	}
+	
+	constexpr EnumeratorMask operator&(EnumType a) const
+	{ 
+		EnumeratorMask m(m_data & Meta::MaskConverter::get_data(a));
+		return m;
+	}
+	
+	constexpr EnumeratorMask operator&(EnumeratorMask a) const
+	{ 
+		EnumeratorMask m(m_data & a.m_data);
+		return m;
+	}
+	
+	constexpr EnumeratorMask operator&=(EnumType a)
+	{ 
+		m_data = m_data & Meta::MaskConverter::get_data(a);
+		return *this;
+	}
+	
+	constexpr EnumeratorMask operator&=(EnumeratorMask a)
+	{ 
+		m_data = m_data & a.m_data;
+		return *this;
+	}
+	
+	constexpr EnumeratorMask operator^(EnumType a) const
+	{ 
+		EnumeratorMask m(m_data ^ Meta::MaskConverter::get_data(a));
+		return m;
+	}
+	
+	constexpr EnumeratorMask operator^(EnumeratorMask a) const
+	{ 
+		EnumeratorMask m(m_data ^ a.m_data);
+		return m;
+	}
+	
+	constexpr EnumeratorMask operator^=(EnumType a)
+	{ 
+		m_data = m_data ^ Meta::MaskConverter::get_data(a);
+		return *this;
+	}
+	
+	constexpr EnumeratorMask operator^=(EnumeratorMask a)
+	{ 
+		m_data = m_data ^ a.m_data;
+		return *this;
+	}
+	
+	constexpr EnumeratorMask operator~() const
+	{ 
+		EnumeratorMask m(~m_data);
+		return m;
+	}
+	
+	constexpr Iterator begin() const
+	{
+		return Iterator(this);
+	}
+	
+	constexpr Iterator end() const
+	{
+		return Iterator(this, BIT_LENGTH + 1);
+	}
+	
+	constexpr Iterator cbegin() const
+	{
+		return Iterator(this);
+	}
+	
+	constexpr Iterator cend() const
+	{
+		return Iterator(this, BIT_LENGTH + 1);
+	}
+		
+	constexpr ReverseIterator rbegin() const
+	{
+		return ReverseIterator(this);
+	}
+	
+	constexpr ReverseIterator rend() const
+	{
+		return ReverseIterator(this, 0);
+	}
+	
+	constexpr ReverseIterator crbegin() const
+	{
+		return ReverseIterator(this);
+	}
+	
+	constexpr ReverseIterator crend() const
+	{
+		return ReverseIterator(this, 0);
+	}
+	
+	// Returns the index of the first set bit, 0 if the mask is empty
+	constexpr size_t find_first() const
+	{
+		return find_next(0);
+	}
+	
+	// Returns the index of the first set bit after index, 0 if there is none
+	constexpr size_t find_next(size_t index) const
+	{
+		auto bit = Bits::find_next(m_data, index, BIT_LENGTH);
+		return bit != Bits::NOT_FOUND ? bit + 1 : 0;
+	}
+	
+	// Returns the index of the last set bit before index, 0 if there is none
+	constexpr size_t find_prev(size_t index) const
+	{
+		if (index <= 1)
+			return 0;
+		
+		auto bit = Bits::find_prev(m_data, index - 2, BIT_LENGTH);
+		return bit != Bits::NOT_FOUND ? bit + 1 : 0;
+	}
+	
+	// Returns the index of the last set bit, 0 if the mask is empty
+	constexpr size_t find_last() const
+	{
+		return find_prev(BIT_LENGTH + 1);
+	}
+	
+	// Returns the amount of set bits
+	constexpr size_t count() const
+	{
+		return Bits::count(m_data, BIT_LENGTH);
+	}
+	
+	constexpr size_t size() const
+	{
+		return count();
+	}
+	
+	// Returns the index-th (0-based) set value, in ascending order
+	constexpr EnumType at(size_t index) const
+	{
+		auto bit = Bits::select(m_data, index, BIT_LENGTH);
+		
+		if (bit == Bits::NOT_FOUND)
+			return {};
+		
+		return Meta::MaskConverter::get_bit(bit + 1);
+	}
+	
+	// Writes the names of the set values separated by ", " into buffer, without allocating. At most capacity - 1 characters are written followed
+	// by a null terminator, the returned value is the length of the full text so the output was truncated if it is greater or equal to capacity
+	size_t format_to(char* buffer, size_t capacity) const
+	{
+		size_t length = 0;
+		
+		formatEach([&](const char* text, size_t text_length) {
+			if (length < capacity)
+			{
+				auto count = text_length < capacity - length ? text_length : capacity - length;
+				std::memcpy(buffer + length, text, count);
+			}
+			
+			length += text_length;
+		});
+		
+		if (capacity > 0)
+			buffer[length < capacity ? length : capacity - 1] = '\0';
+		
+		return length;
+	}
+	
+	// Writes the names of the set values separated by ", " to output, returns the iterator past the last written character
+	template <typename OutputIt>
+	OutputIt format_to(OutputIt output) const
+	{
+		formatEach([&](const char* text, size_t text_length) {
+			for (size_t i = 0; i < text_length; ++i)
+			{
+				*output++ = text[i];
+			}
+		});
+		
+		return output;
+	}
+	
+	std::string toString() const
+	{
+		std::string text;
+		format_to(std::back_inserter(text));
+		
+		return text;
+	}
+	
+protected:
+	template <typename Function>
+	void formatEach(Function&& write) const
+	{
+		using Info = EnumeratorInfo<EnumType>;
+		bool first = true;
+		
+		for (auto value : *this)
+		{
+			if (!first)
+				write(", ", 2);
+			
+			first = false;
+			auto entry = Info::find(value);
+			
+			if (entry && (*entry).get_name() != nullptr)
+				write((*entry).get_name(), Info::get_name_length(*entry));
+		}
+	}
+	
+protected:
+	DataType m_data;
+};
+
+
+// Mask which can be read and modified concurrently without locks. Masks up to 64 bits are held in a single std::atomic<DataType>, wider masks
+// in one atomic per word, so operations on a single value only touch the word holding it; operations on whole masks are atomic per word only
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorAtomicMask
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	
+public:
+	using InnerType = EnumType;
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using DataType = typename MaskType::DataType;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	
+protected:
+	using Words = EnumeratorDataWords<DataType>;
+	
+public:
+	using WordType = EnumeratorStorageWordType<DataType>;
+	static constexpr const size_t WORD_BITS = std::numeric_limits<WordType>::digits;
+	static constexpr const size_t WORD_COUNT = Words::WORD_COUNT;
+	
+public:
+	EnumeratorAtomicMask() noexcept
+	{
+		store(MaskType{}, std::memory_order_relaxed);
+	}
+	
+	EnumeratorAtomicMask(MaskType mask) noexcept
+	{
+		store(mask, std::memory_order_relaxed);
+	}
+	
+	EnumeratorAtomicMask(const EnumeratorAtomicMask&) = delete;
+	EnumeratorAtomicMask& operator=(const EnumeratorAtomicMask&) = delete;
+	
+public:
+	bool is_lock_free() const
+	{
+		return _words[0].is_lock_free();
+	}
+	
+	MaskType load(std::memory_order order = std::memory_order_seq_cst) const
+	{
+		DataType data{};
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			Words::set_word(data, i, _words[i].load(order));
+		}
+		
+		return MaskType(data);
+	}
+	
+	void store(MaskType mask, std::memory_order order = std::memory_order_seq_cst)
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			_words[i].store(static_cast<WordType>(Words::get_word(mask.data(), i)), order);
+		}
+	}
+	
+	bool has(EnumType bit, std::memory_order order = std::memory_order_seq_cst) const
+	{
+		size_t index;
+		WordType bits;
+		
+		if (locate(bit, index, bits))
+			return (_words[index].load(order) & bits) == bits;
+		
+		return has(MaskType(bit), order);
+	}
+	
+	bool has(MaskType mask, std::memory_order order = std::memory_order_seq_cst) const
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			auto bits = static_cast<WordType>(Words::get_word(mask.data(), i));
+			
+			if (bits != 0 && (_words[i].load(order) & bits) != bits)
+				return false;
+		}
+		
+		return true;
+	}
+	
+	bool has_any(MaskType mask, std::memory_order order = std::memory_order_seq_cst) const
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			auto bits = static_cast<WordType>(Words::get_word(mask.data(), i));
+			
+			if (bits != 0 && (_words[i].load(order) & bits) != 0)
+				return true;
+		}
+		
+		return false;
+	}
+	
+	// Sets bit and returns whether it was set already
+	bool set(EnumType bit, std::memory_order order = std::memory_order_seq_cst)
+	{
+		size_t index;
+		WordType bits;
+		
+		if (locate(bit, index, bits))
+			return (_words[index].fetch_or(bits, order) & bits) == bits;
+		
+		return fetch_or(MaskType(bit), order).has(bit);
+	}
+	
+	// Sets or clears bit and returns whether it was set before
+	bool set(EnumType bit, bool value, std::memory_order order = std::memory_order_seq_cst)
+	{
+		return value ? set(bit, order) : clear(bit, order);
+	}
+	
+	// Clears bit and returns whether it was set before
+	bool clear(EnumType bit, std::memory_order order = std::memory_order_seq_cst)
+	{
+		size_t index;
+		WordType bits;
+		
+		if (locate(bit, index, bits))
+			return (_words[index].fetch_and(static_cast<WordType>(~bits), order) & bits) == bits;
+		
+		return fetch_and(~MaskType(bit), order).has(bit);
+	}
+	
+	void clear(std::memory_order order = std::memory_order_seq_cst)
+	{
+		store(MaskType{}, order);
+	}
+	
+	// Returns the previous value of the mask
+	MaskType fetch_or(MaskType mask, std::memory_order order = std::memory_order_seq_cst)
+	{
+		DataType data{};
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			auto bits = static_cast<WordType>(Words::get_word(mask.data(), i));
+			Words::set_word(data, i, bits != 0 ? _words[i].fetch_or(bits, order) : _words[i].load(order));
+		}
+		
+		return MaskType(data);
+	}
+	
+	// Returns the previous value of the mask
+	MaskType fetch_and(MaskType mask, std::memory_order order = std::memory_order_seq_cst)
+	{
+		DataType data{};
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			auto bits = static_cast<WordType>(Words::get_word(mask.data(), i));
+			Words::set_word(data, i, bits != static_cast<WordType>(~static_cast<WordType>(0)) ? _words[i].fetch_and(bits, order) : _words[i].load(order));
+		}
+		
+		return MaskType(data);
+	}
+	
+	// Returns the previous value of the mask
+	MaskType fetch_xor(MaskType mask, std::memory_order order = std::memory_order_seq_cst)
+	{
+		DataType data{};
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			auto bits = static_cast<WordType>(Words::get_word(mask.data(), i));
+			Words::set_word(data, i, bits != 0 ? _words[i].fetch_xor(bits, order) : _words[i].load(order));
+		}
+		
+		return MaskType(data);
+	}
+	
+protected:
+	// Finds the word and bit of a value when values map to a single bit, returns false otherwise
+	static bool locate(EnumType bit, size_t& index, WordType& bits)
+	{
+		if (!Meta::bitwise_conversion)
+			return false;
+		
+		auto position = static_cast<size_t>(static_cast<typename std::make_unsigned<EnumType>::type>(bit));
+		
+		if (position == 0 || position > BIT_LENGTH)
+			return false;
+		
+		index = (position - 1) / WORD_BITS;
+		bits = static_cast<WordType>(static_cast<WordType>(1) << ((position - 1) % WORD_BITS));
+		return true;
+	}
+	
+protected:
+	std::atomic<WordType> _words[WORD_COUNT];
+};
+
+
+// Collection of masks stored word-major: word i of every mask is contiguous, so filters only read the words involved in the query
+// and evaluate whole blocks of masks per instruction. Filters either fill a bitmap, bit i being set if mask i matches, or append
+// the indices of the matching masks to a selection vector; both return the amount of matching masks
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskArray
+{
+public:
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using DataType = typename MaskType::DataType;
+	using WordType = EnumeratorStorageWordType<DataType>;
+	using IndexType = uint32_t;
+	using BitmapType = uint64_t;
+	static constexpr const size_t BLOCK_SIZE = std::numeric_limits<BitmapType>::digits;
+	
+protected:
+	using Words = EnumeratorDataWords<DataType>;
+	static constexpr const size_t WORD_COUNT = Words::WORD_COUNT;
+	
+public:
+	// Returns the amount of BitmapType words needed by a bitmap covering count masks
+	static constexpr size_t get_bitmap_size(size_t count)
+	{
+		return (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	}
+	
+public:
+	size_t size() const
+	{
+		return _columns[0].size();
+	}
+	
+	bool empty() const
+	{
+		return _columns[0].empty();
+	}
+	
+	void reserve(size_t count)
+	{
+		for (auto&& column : _columns)
+		{
+			column.reserve(count);
+		}
+	}
+	
+	void resize(size_t count)
+	{
+		for (auto&& column : _columns)
+		{
+			column.resize(count);
+		}
+	}
+	
+	void clear()
+	{
+		for (auto&& column : _columns)
+		{
+			column.clear();
+		}
+	}
+	
+	void push_back(MaskType mask)
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			_columns[i].push_back(static_cast<WordType>(Words::get_word(mask.data(), i)));
+		}
+	}
+	
+	MaskType get(size_t index) const
+	{
+		DataType data{};
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			Words::set_word(data, i, _columns[i][index]);
+		}
+		
+		return MaskType(data);
+	}
+	
+	void set(size_t index, MaskType mask)
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			_columns[i][index] = static_cast<WordType>(Words::get_word(mask.data(), i));
+		}
+	}
+	
+	MaskType operator[](size_t index) const
+	{
+		return get(index);
+	}
+	
+	// Returns the words at index of all the masks
+	const WordType* column(size_t index) const
+	{
+		return _columns[index].data();
+	}
+	
+	// Masks which have all the values of required, bitmap must hold get_bitmap_size(size()) words
+	size_t filter_has(MaskType required, BitmapType* bitmap) const
+	{
+		return filter(required, {}, {}, false, BitmapWriter{bitmap});
+	}
+	
+	size_t filter_has(MaskType required, std::vector<IndexType>& selection) const
+	{
+		return filter(required, {}, {}, false, SelectionWriter{selection});
+	}
+	
+	// Masks which have at least one of the values of any
+	size_t filter_has_any(MaskType any, BitmapType* bitmap) const
+	{
+		return filter({}, any, {}, true, BitmapWriter{bitmap});
+	}
+	
+	size_t filter_has_any(MaskType any, std::vector<IndexType>& selection) const
+	{
+		return filter({}, any, {}, true, SelectionWriter{selection});
+	}
+	
+	// Masks which have none of the values of forbidden
+	size_t filter_none(MaskType forbidden, BitmapType* bitmap) const
+	{
+		return filter({}, {}, forbidden, false, BitmapWriter{bitmap});
+	}
+	
+	size_t filter_none(MaskType forbidden, std::vector<IndexType>& selection) const
+	{
+		return filter({}, {}, forbidden, false, SelectionWriter{selection});
+	}
+	
+	// Masks which have all the values of required and none of the values of forbidden, in a single pass
+	size_t filter_has_none(MaskType required, MaskType forbidden, BitmapType* bitmap) const
+	{
+		return filter(required, {}, forbidden, false, BitmapWriter{bitmap});
+	}
+	
+	size_t filter_has_none(MaskType required, MaskType forbidden, std::vector<IndexType>& selection) const
+	{
+		return filter(required, {}, forbidden, false, SelectionWriter{selection});
+	}
+	
+protected:
+	struct BitmapWriter
+	{
+		BitmapType* bitmap;
+		
+		void operator()(size_t block, BitmapType bits)
+		{
+			bitmap[block] = bits;
+		}
+	};
+	
+	struct SelectionWriter
+	{
+		std::vector<IndexType>& selection;
+		
+		void operator()(size_t block, BitmapType bits)
+		{
+			while (bits != 0)
+			{
+				selection.push_back(static_cast<IndexType>(block * BLOCK_SIZE + EnumeratorBits::count_trailing_zeros(bits)));
+				bits &= bits - 1;
+			}
+		}
+	};
+	
+	// Evaluates has(required) && (!use_any || has_any(any)) && !has_any(forbidden) one block of masks at a time, skipping the words
+	// which aren't part of the query, and passes each block bitmap to write
+	template <typename Writer>
+	size_t filter(MaskType required, MaskType any, MaskType forbidden, bool use_any, Writer&& write) const
+	{
+		const size_t count = size();
+		size_t total = 0;
+		WordType required_words[WORD_COUNT];
+		WordType any_words[WORD_COUNT];
+		WordType forbidden_words[WORD_COUNT];
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			required_words[i] = static_cast<WordType>(Words::get_word(required.data(), i));
+			any_words[i] = static_cast<WordType>(Words::get_word(any.data(), i));
+			forbidden_words[i] = static_cast<WordType>(Words::get_word(forbidden.data(), i));
+		}
+		
+		for (size_t start = 0; start < count; start += BLOCK_SIZE)
+		{
+			const size_t length = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+			BitmapType matches = length < BLOCK_SIZE ? (static_cast<BitmapType>(1) << length) - 1 : ~static_cast<BitmapType>(0);
+			BitmapType hits = 0;
+			
+			for (size_t i = 0; i < WORD_COUNT && matches != 0; ++i)
+			{
+				const WordType* words = _columns[i].data() + start;
+				
+				if (required_words[i] != 0)
+					matches &= matchBlock(words, required_words[i], required_words[i], length);
+				
+				if (forbidden_words[i] != 0)
+					matches &= matchBlock(words, forbidden_words[i], static_cast<WordType>(0), length);
+				
+				if (any_words[i] != 0)
+					hits |= ~matchBlock(words, any_words[i], static_cast<WordType>(0), length);
+			}
+			
+			if (use_any)
+				matches &= hits;
+			
+			total += EnumeratorBits::popcount(matches);
+			write(start / BLOCK_SIZE, matches);
+		}
+		
+		return total;
+	}
+	
+	// Returns a bitmap where bit j is set if (words[j] & mask) == expected, for the first length words
+	template <typename T>
+	static BitmapType matchBlock(const T* words, T mask, T expected, size_t length)
+	{
+		BitmapType bits = 0;
+		
+		for (size_t j = 0; j < length; ++j)
+		{
+			bits |= static_cast<BitmapType>(static_cast<T>(words[j] & mask) == expected) << j;
+		}
+		
+		return bits;
+	}
+	
+#if defined(METAENUMERATOR_AVX512)
+	static BitmapType matchBlock(const unsigned long long* words, unsigned long long mask, unsigned long long expected, size_t length)
+	{
+		if (length < BLOCK_SIZE)
+			return matchBlock<unsigned long long>(words, mask, expected, length);
+		
+		const __m512i mask_vector = _mm512_set1_epi64(static_cast<long long>(mask));
+		const __m512i expected_vector = _mm512_set1_epi64(static_cast<long long>(expected));
+		BitmapType bits = 0;
+		
+		for (size_t j = 0; j < BLOCK_SIZE; j += 8)
+		{
+			auto vector = _mm512_and_si512(_mm512_loadu_si512(words + j), mask_vector);
+			bits |= static_cast<BitmapType>(_mm512_cmpeq_epi64_mask(vector, expected_vector)) << j;
+		}
+		
+		return bits;
+	}
+#elif defined(METAENUMERATOR_AVX2)
+	static BitmapType matchBlock(const unsigned long long* words, unsigned long long mask, unsigned long long expected, size_t length)
+	{
+		if (length < BLOCK_SIZE)
+			return matchBlock<unsigned long long>(words, mask, expected, length);
+		
+		const __m256i mask_vector = _mm256_set1_epi64x(static_cast<long long>(mask));
+		const __m256i expected_vector = _mm256_set1_epi64x(static_cast<long long>(expected));
+		BitmapType bits = 0;
+		
+		for (size_t j = 0; j < BLOCK_SIZE; j += 4)
+		{
+			auto vector = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + j)), mask_vector);
+			auto equal = _mm256_cmpeq_epi64(vector, expected_vector);
+			bits |= static_cast<BitmapType>(static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(equal)))) << j;
+		}
+		
+		return bits;
+	}
+#elif defined(METAENUMERATOR_SSE2)
+	static BitmapType matchBlock(const unsigned long long* words, unsigned long long mask, unsigned long long expected, size_t length)
+	{
+		if (length < BLOCK_SIZE)
+			return matchBlock<unsigned long long>(words, mask, expected, length);
+		
+		const __m128i mask_vector = _mm_set1_epi64x(static_cast<long long>(mask));
+		const __m128i expected_vector = _mm_set1_epi64x(static_cast<long long>(expected));
+		BitmapType bits = 0;
+		
+		for (size_t j = 0; j < BLOCK_SIZE; j += 2)
+		{
+			// SSE2 lacks 64-bit comparisons, both 32-bit halves have to be equal
+			auto vector = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words + j)), mask_vector);
+			auto equal = _mm_cmpeq_epi32(vector, expected_vector);
+			equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+			bits |= static_cast<BitmapType>(static_cast<unsigned int>(_mm_movemask_pd(_mm_castsi128_pd(equal)))) << j;
+		}
+		
+		return bits;
+	}
+#endif
+	
+protected:
+	std::vector<WordType> _columns[WORD_COUNT];
+};
+
+
+// Default executor of EnumeratorMaskScan, runs work(0) on the calling thread and work(1) to work(worker_count - 1) on new threads.
+// Custom executors (e.g. backed by a thread pool) provide the same two functions, operator() must return once every worker has returned
+struct EnumeratorThreadExecutor
+{
+	size_t get_concurrency() const
+	{
+		auto concurrency = std::thread::hardware_concurrency();
+		return concurrency > 0 ? concurrency : 1;
+	}
+	
+	template <typename Work>
+	void operator()(size_t worker_count, Work&& work) const
+	{
+		Threads threads;
+		threads.reserve(worker_count > 0 ? worker_count - 1 : 0);
+		
+		for (size_t i = 1; i < worker_count; ++i)
+		{
+			threads.emplace_back([&work, i]() { work(i); });
+		}
+		
+		work(0);
+	}
+	
+protected:
+	// Joins the started threads on every way out, including when starting a thread or work(0) throws
+	struct Threads : std::vector<std::thread>
+	{
+		~Threads()
+		{
+			for (auto&& thread : *this)
+			{
+				if (thread.joinable())
+					thread.join();
+			}
+		}
+	};
+};
+
+// Filters a contiguous range of masks on several threads. The range is split in chunks sized to stay in cache, which the workers claim
+// one at a time from a shared counter so that faster workers take over the remaining chunks. Results are the same as a sequential scan:
+// bitmaps get bit i set if masks[i] matches, selection vectors get the indices of the matching masks appended in ascending order
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskScan
+{
+public:
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using IndexType = uint32_t;
+	using BitmapType = uint64_t;
+	static constexpr const size_t BLOCK_SIZE = std::numeric_limits<BitmapType>::digits;
+	static constexpr const size_t CHUNK_BYTES = 64 * 1024;
+	static constexpr const size_t CHUNK_SIZE = CHUNK_BYTES / sizeof(MaskType) > BLOCK_SIZE ? CHUNK_BYTES / sizeof(MaskType) / BLOCK_SIZE * BLOCK_SIZE : BLOCK_SIZE;
+	
+public:
+	template <typename Output, typename Executor = EnumeratorThreadExecutor>
+	static size_t filter_has(const MaskType* masks, size_t count, MaskType required, Output&& output, Executor&& executor = Executor())
+	{
+		return filter(masks, count, [required](const MaskType& mask) { return mask.has(required); }, output, executor);
+	}
+	
+	template <typename Output, typename Executor = EnumeratorThreadExecutor>
+	static size_t filter_has_any(const MaskType* masks, size_t count, MaskType any, Output&& output, Executor&& executor = Executor())
+	{
+		return filter(masks, count, [any](const MaskType& mask) { return mask.has_any(any); }, output, executor);
+	}
+	
+	template <typename Output, typename Executor = EnumeratorThreadExecutor>
+	static size_t filter_none(const MaskType* masks, size_t count, MaskType forbidden, Output&& output, Executor&& executor = Executor())
+	{
+		return filter(masks, count, [forbidden](const MaskType& mask) { return !mask.has_any(forbidden); }, output, executor);
+	}
+	
+	template <typename Output, typename Executor = EnumeratorThreadExecutor>
+	static size_t filter_has_none(const MaskType* masks, size_t count, MaskType required, MaskType forbidden, Output&& output, Executor&& executor = Executor())
+	{
+		return filter(masks, count, [required, forbidden](const MaskType& mask) { return mask.has(required) && !mask.has_any(forbidden); }, output, executor);
+	}
+	
+	template <typename Output, typename Executor = EnumeratorThreadExecutor>
+	static size_t filter_equals(const MaskType* masks, size_t count, MaskType value, Output&& output, Executor&& executor = Executor())
+	{
+		return filter(masks, count, [value](const MaskType& mask) { return mask == value; }, output, executor);
+	}
+	
+	// Fills bitmap, which must hold (count + 63) / 64 words, and returns the amount of matching masks
+	template <typename Predicate, typename Executor = EnumeratorThreadExecutor>
+	static size_t filter(const MaskType* masks, size_t count, Predicate&& predicate, BitmapType* bitmap, Executor&& executor = Executor())
+	{
+		return run(count, executor, [&](size_t, size_t begin, size_t end) {
+			size_t total = 0;
+			
+			for (size_t start = begin; start < end; start += BLOCK_SIZE)
+			{
+				const size_t length = end - start < BLOCK_SIZE ? end - start : BLOCK_SIZE;
+				BitmapType bits = 0;
+				
+				for (size_t j = 0; j < length; ++j)
+				{
+					bits |= static_cast<BitmapType>(predicate(masks[start + j]) ? 1 : 0) << j;
+				}
+				
+				bitmap[start / BLOCK_SIZE] = bits;
+				total += EnumeratorBits::popcount(bits);
+			}
+			
+			return total;
+		});
+	}
+	
+	// Appends the indices of the matching masks to selection and returns their amount
+	template <typename Predicate, typename Executor = EnumeratorThreadExecutor>
+	static size_t filter(const MaskType* masks, size_t count, Predicate&& predicate, std::vector<IndexType>& selection, Executor&& executor = Executor())
+	{
+		std::vector<std::vector<IndexType>> chunks(getChunkCount(count));
+		
+		auto total = run(count, executor, [&](size_t chunk, size_t begin, size_t end) {
+			auto&& indices = chunks[chunk];
+			
+			for (size_t i = begin; i < end; ++i)
+			{
+				if (predicate(masks[i]))
+					indices.push_back(static_cast<IndexType>(i));
+			}
+			
+			return indices.size();
+		});
+		
+		selection.reserve(selection.size() + total);
+		
+		for (auto&& indices : chunks)
+		{
+			selection.insert(selection.end(), indices.begin(), indices.end());
+		}
+		
+		return total;
+	}
+	
+protected:
+	static size_t getChunkCount(size_t count)
+	{
+		return (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	}
+	
+	// Calls function(chunk, begin, end) once for every chunk and returns the sum of the results
+	template <typename Executor, typename Function>
+	static size_t run(size_t count, Executor&& executor, Function&& function)
+	{
+		const size_t chunk_count = getChunkCount(count);
+		size_t worker_count = executor.get_concurrency();
+		
+		if (worker_count > chunk_count)
+			worker_count = chunk_count;
+		
+		std::atomic<size_t> next_chunk{0};
+		std::atomic<size_t> total{0};
+		
+		auto work = [&](size_t) {
+			size_t found = 0;
+			
+			for (size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed); chunk < chunk_count; chunk = next_chunk.fetch_add(1, std::memory_order_relaxed))
+			{
+				const size_t begin = chunk * CHUNK_SIZE;
+				found += function(chunk, begin, count - begin < CHUNK_SIZE ? count : begin + CHUNK_SIZE);
+			}
+			
+			total.fetch_add(found, std::memory_order_relaxed);
+		};
+		
+		if (worker_count <= 1)
+			work(0);
+		else
+			executor(worker_count, work);
+		
+		return total.load(std::memory_order_relaxed);
+	}
+};
+
+// Sorted set of 32-bit ids stored in roaring-style chunks: ids sharing their high 16 bits belong to the same chunk, which stores their
+// low 16 bits in a sorted array while sparse and in a 65536 bits bitmap once it holds more than ARRAY_LIMIT ids
+class EnumeratorPostingList
+{
+public:
+	using IdType = uint32_t;
+	using BitmapType = uint64_t;
+	static constexpr const size_t ARRAY_LIMIT = 4096;
+	static constexpr const size_t BITMAP_SIZE = 65536 / std::numeric_limits<BitmapType>::digits;
+	
+	struct Chunk
+	{
+		uint16_t key{};
+		size_t cardinality{};
+		std::vector<uint16_t> array;
+		std::vector<BitmapType> bitmap;
+		
+		bool is_bitmap() const
+		{
+			return !bitmap.empty();
+		}
+		
+		bool contains(uint16_t low) const
+		{
+			if (is_bitmap())
+				return (bitmap[low / 64] >> (low % 64)) & 1;
+			
+			return std::binary_search(array.begin(), array.end(), low);
+		}
+		
+		// Writes the chunk as a bitmap of BITMAP_SIZE words
+		void copy_to(BitmapType* words) const
+		{
+			if (is_bitmap())
+			{
+				std::memcpy(words, bitmap.data(), BITMAP_SIZE * sizeof(BitmapType));
+				return;
+			}
+			
+			std::memset(words, 0, BITMAP_SIZE * sizeof(BitmapType));
+			
+			for (auto low : array)
+			{
+				words[low / 64] |= static_cast<BitmapType>(1) << (low % 64);
+			}
+		}
+		
+		// Clears the bits of words which aren't part of the chunk
+		void and_into(BitmapType* words) const
+		{
+			if (is_bitmap())
+			{
+				for (size_t i = 0; i < BITMAP_SIZE; ++i)
+					words[i] &= bitmap[i];
+				
+				return;
+			}
+			
+			size_t next = 0;
+			
+			for (size_t i = 0; i < array.size();)
+			{
+				const size_t index = array[i] / 64;
+				BitmapType kept = 0;
+				
+				for (; i < array.size() && array[i] / 64 == index; ++i)
+					kept |= static_cast<BitmapType>(1) << (array[i] % 64);
+				
+				for (; next < index; ++next)
+					words[next] = 0;
+				
+				words[index] &= kept;
+				next = index + 1;
+			}
+			
+			for (; next < BITMAP_SIZE; ++next)
+				words[next] = 0;
+		}
+		
+		// Clears the bits of words which are part of the chunk
+		void andnot_into(BitmapType* words) const
+		{
+			if (is_bitmap())
+			{
+				for (size_t i = 0; i < BITMAP_SIZE; ++i)
+					words[i] &= ~bitmap[i];
+				
+				return;
+			}
+			
+			for (auto low : array)
+			{
+				words[low / 64] &= ~(static_cast<BitmapType>(1) << (low % 64));
+			}
+		}
+	};
+	
+public:
+	size_t size() const
+	{
+		return _size;
+	}
+	
+	bool empty() const
+	{
+		return _size == 0;
+	}
+	
+	const std::vector<Chunk>& get_chunks() const
+	{
+		return _chunks;
+	}
+	
+	// Returns the chunk holding the ids whose high 16 bits are key, nullptr if there is none
+	const Chunk* find_chunk(uint16_t key) const
+	{
+		auto it = findChunk(key);
+		return it != _chunks.end() && it->key == key ? &*it : nullptr;
+	}
+	
+	bool contains(IdType id) const
+	{
+		auto chunk = find_chunk(static_cast<uint16_t>(id >> 16));
+		return chunk != nullptr && chunk->contains(static_cast<uint16_t>(id));
+	}
+	
+	// Returns false if id was already part of the list
+	bool add(IdType id)
+	{
+		const auto key = static_cast<uint16_t>(id >> 16);
+		const auto low = static_cast<uint16_t>(id);
+		auto it = findChunk(key);
+		
+		if (it == _chunks.end() || it->key != key)
+		{
+			it = _chunks.insert(it, Chunk{});
+			it->key = key;
+		}
+		
+		if (it->is_bitmap())
+		{
+			auto&& word = it->bitmap[low / 64];
+			const auto bit = static_cast<BitmapType>(1) << (low % 64);
+			
+			if (word & bit)
+				return false;
+			
+			word |= bit;
+		}
+		else
+		{
+			auto position = std::lower_bound(it->array.begin(), it->array.end(), low);
+			
+			if (position != it->array.end() && *position == low)
+				return false;
+			
+			if (it->array.size() < ARRAY_LIMIT)
+			{
+				it->array.insert(position, low);
+			}
+			else
+			{
+				toBitmap(*it);
+				it->bitmap[low / 64] |= static_cast<BitmapType>(1) << (low % 64);
+			}
+		}
+		
+		++it->cardinality;
+		++_size;
+		return true;
+	}
+	
+	// Returns false if id wasn't part of the list
+	bool remove(IdType id)
+	{
+		const auto key = static_cast<uint16_t>(id >> 16);
+		const auto low = static_cast<uint16_t>(id);
+		auto it = findChunk(key);
+		
+		if (it == _chunks.end() || it->key != key)
+			return false;
+		
+		if (it->is_bitmap())
+		{
+			auto&& word = it->bitmap[low / 64];
+			const auto bit = static_cast<BitmapType>(1) << (low % 64);
+			
+			if (!(word & bit))
+				return false;
+			
+			word &= ~bit;
+		}
+		else
+		{
+			auto position = std::lower_bound(it->array.begin(), it->array.end(), low);
+			
+			if (position == it->array.end() || *position != low)
+				return false;
+			
+			it->array.erase(position);
+		}
+		
+		--_size;
+		
+		if (--it->cardinality == 0)
+			_chunks.erase(it);
+		else if (it->is_bitmap() && it->cardinality <= ARRAY_LIMIT / 2)
+			toArray(*it); // converting back at half the limit avoids flipping between both forms around it
+		
+		return true;
+	}
+	
+	// Calls function(id) for each id, in ascending order
+	template <typename Function>
+	void for_each(Function&& function) const
+	{
+		for (auto&& chunk : _chunks)
+		{
+			const IdType base = static_cast<IdType>(chunk.key) << 16;
+			
+			if (!chunk.is_bitmap())
+			{
+				for (auto low : chunk.array)
+					function(base | low);
+				
+				continue;
+			}
+			
+			for (size_t i = 0; i < BITMAP_SIZE; ++i)
+			{
+				for (auto word = chunk.bitmap[i]; word != 0; word &= word - 1)
+					function(base | static_cast<IdType>(i * 64 + EnumeratorBits::count_trailing_zeros(word)));
+			}
+		}
+	}
+	
+protected:
+	std::vector<Chunk>::const_iterator findChunk(uint16_t key) const
+	{
+		return std::lower_bound(_chunks.begin(), _chunks.end(), key, [](const Chunk& chunk, uint16_t value) { return chunk.key < value; });
+	}
+	
+	std::vector<Chunk>::iterator findChunk(uint16_t key)
+	{
+		return std::lower_bound(_chunks.begin(), _chunks.end(), key, [](const Chunk& chunk, uint16_t value) { return chunk.key < value; });
+	}
+	
+	static void toBitmap(Chunk& chunk)
+	{
+		chunk.bitmap.assign(BITMAP_SIZE, 0);
+		
+		for (auto low : chunk.array)
+		{
+			chunk.bitmap[low / 64] |= static_cast<BitmapType>(1) << (low % 64);
+		}
+		
+		std::vector<uint16_t>().swap(chunk.array);
+	}
+	
+	static void toArray(Chunk& chunk)
+	{
+		chunk.array.reserve(chunk.cardinality);
+		
+		for (size_t i = 0; i < BITMAP_SIZE; ++i)
+		{
+			for (auto word = chunk.bitmap[i]; word != 0; word &= word - 1)
+				chunk.array.push_back(static_cast<uint16_t>(i * 64 + EnumeratorBits::count_trailing_zeros(word)));
+		}
+		
+		std::vector<BitmapType>().swap(chunk.bitmap);
+	}
+	
+protected:
+	std::vector<Chunk> _chunks;
+	size_t _size{};
+};
+
+// Inverted index from the values of a mask to the ids of the entities whose mask has them, answering "which entities have these values
+// and none of those" by intersecting posting lists instead of scanning every mask. The index has to be told about every mask change
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskIndex
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	
+public:
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using PostingList = EnumeratorPostingList;
+	using IdType = PostingList::IdType;
+	using BitmapType = PostingList::BitmapType;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	
+public:
+	EnumeratorMaskIndex() : _postings(BIT_LENGTH)
+	{	}
+	
+	// Indexes the masks of a range of entities, whose ids are first_id, first_id + 1, ...
+	void add(const MaskType* masks, size_t count, IdType first_id = 0)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			add(static_cast<IdType>(first_id + i), masks[i]);
+		}
+	}
+	
+	void add(IdType id, MaskType mask)
+	{
+		_entities.add(id);
+		
+		for (auto index = mask.find_first(); index != 0; index = mask.find_next(index))
+		{
+			_postings[index - 1].add(id);
+		}
+	}
+	
+	void remove(IdType id, MaskType mask)
+	{
+		_entities.remove(id);
+		
+		for (auto index = mask.find_first(); index != 0; index = mask.find_next(index))
+		{
+			_postings[index - 1].remove(id);
+		}
+	}
+	
+	// Only touches the posting lists of the values which differ between previous and mask
+	void update(IdType id, MaskType previous, MaskType mask)
+	{
+		auto changed = previous.data() ^ mask.data();
+		MaskType added(mask.data() & changed);
+		MaskType removed(previous.data() & changed);
+		
+		for (auto index = added.find_first(); index != 0; index = added.find_next(index))
+		{
+			_postings[index - 1].add(id);
+		}
+		
+		for (auto index = removed.find_first(); index != 0; index = removed.find_next(index))
+		{
+			_postings[index - 1].remove(id);
+		}
+	}
+	
+	size_t size() const
+	{
+		return _entities.size();
+	}
+	
+	const PostingList& get_entities() const
+	{
+		return _entities;
+	}
+	
+	const PostingList& get_postings(EnumType value) const
+	{
+		auto index = MaskType(value).find_first();
+		return index != 0 ? _postings[index - 1] : _empty;
+	}
+	
+	// Appends the ids of the entities which have all the values of required and none of the values of forbidden, in ascending order,
+	// and returns their amount. An empty required mask matches every indexed entity
+	size_t query(MaskType required, MaskType forbidden, std::vector<IdType>& result) const
+	{
+		std::vector<const PostingList*> required_lists;
+		std::vector<const PostingList*> forbidden_lists;
+		
+		for (auto index = required.find_first(); index != 0; index = required.find_next(index))
+		{
+			if (_postings[index - 1].empty())
+				return 0;
+			
+			required_lists.push_back(&_postings[index - 1]);
+		}
+		
+		for (auto index = forbidden.find_first(); index != 0; index = forbidden.find_next(index))
+		{
+			if (!_postings[index - 1].empty())
+				forbidden_lists.push_back(&_postings[index - 1]);
+		}
+		
+		if (required_lists.empty())
+			required_lists.push_back(&_entities);
+		
+		// Intersecting from the smallest list keeps the amount of probed ids to a minimum
+		std::sort(required_lists.begin(), required_lists.end(), [](const PostingList* a, const PostingList* b) { return a->size() < b->size(); });
+		
+		const size_t initial_size = result.size();
+		std::vector<const PostingList::Chunk*> chunks(required_lists.size() + forbidden_lists.size());
+		std::vector<BitmapType> words;
+		
+		for (auto&& chunk : required_lists[0]->get_chunks())
+		{
+			if (!gatherChunks(chunk.key, required_lists, forbidden_lists, chunks))
+				continue;
+			
+			const IdType base = static_cast<IdType>(chunk.key) << 16;
+			
+			if (!chunk.is_bitmap())
+			{
+				for (auto low : chunk.array)
+				{
+					if (matchChunks(low, required_lists.size(), chunks))
+						result.push_back(base | low);
+				}
+				
+				continue;
+			}
+			
+			words.resize(PostingList::BITMAP_SIZE);
+			chunk.copy_to(words.data());
+			
+			for (size_t i = 1; i < chunks.size(); ++i)
+			{
+				if (i < required_lists.size())
+					chunks[i]->and_into(words.data());
+				else if (chunks[i] != nullptr)
+					chunks[i]->andnot_into(words.data());
+			}
+			
+			for (size_t i = 0; i < PostingList::BITMAP_SIZE; ++i)
+			{
+				for (auto word = words[i]; word != 0; word &= word - 1)
+					result.push_back(base | static_cast<IdType>(i * 64 + EnumeratorBits::count_trailing_zeros(word)));
+			}
+		}
+		
+		return result.size() - initial_size;
+	}
+	
+protected:
+	// Finds the chunks for key of every list, returns false if a required list has none. Forbidden lists without one get a nullptr
+	static bool gatherChunks(uint16_t key, const std::vector<const PostingList*>& required_lists, const std::vector<const PostingList*>& forbidden_lists, std::vector<const PostingList::Chunk*>& chunks)
+	{
+		for (size_t i = 0; i < required_lists.size(); ++i)
+		{
+			chunks[i] = required_lists[i]->find_chunk(key);
+			
+			if (chunks[i] == nullptr)
+				return false;
+		}
+		
+		for (size_t i = 0; i < forbidden_lists.size(); ++i)
+		{
+			chunks[required_lists.size() + i] = forbidden_lists[i]->find_chunk(key);
+		}
+		
+		return true;
+	}
+	
+	static bool matchChunks(uint16_t low, size_t required_count, const std::vector<const PostingList::Chunk*>& chunks)
+	{
+		for (size_t i = 1; i < chunks.size(); ++i)
+		{
+			if (i < required_count ? !chunks[i]->contains(low) : (chunks[i] != nullptr && chunks[i]->contains(low)))
+				return false;
+		}
+		
+		return true;
+	}
+	
+protected:
+	std::vector<PostingList> _postings;
+	PostingList _entities;
+	PostingList _empty;
+};
+
+// Binary encodings of masks, independent from the platform and the storage of the mask:
+// - packed: PACKED_SIZE bytes, bit i of the mask is bit i % 8 of byte i / 8 (little endian). Bulk routines copy whole ranges of masks at once
+//   when the in-memory layout already matches, i.e. on little endian targets with plain storages
+// - sparse: the amount of set bits followed by the gaps between their positions, each as an unsigned LEB128 varint. It takes a byte
+//   or two per set bit, which is far smaller than the packed form for large masks holding few values
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskCodec
+{
+public:
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using DataType = typename MaskType::DataType;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	static constexpr const size_t PACKED_SIZE = (bit_length + CHAR_BIT - 1) / CHAR_BIT;
+	
+	static constexpr size_t get_varint_size(size_t value)
+	{
+		return value < 0x80 ? 1 : 1 + get_varint_size(value >> 7);
+	}
+	
+	// Writes value as an unsigned LEB128 varint and returns its size
+	static size_t write_varint(size_t value, unsigned char* out)
+	{
+		size_t size = 0;
+		
+		for (; value >= 0x80; value >>= 7)
+		{
+			out[size++] = static_cast<unsigned char>(value | 0x80);
+		}
+		
+		out[size++] = static_cast<unsigned char>(value);
+		return size;
+	}
+	
+	// Reads a varint from at most size bytes and returns its size, 0 if it is truncated or overflows
+	static size_t read_varint(const unsigned char* in, size_t size, size_t& value)
+	{
+		value = 0;
+		
+		for (size_t i = 0, shift = 0; i < size && shift < std::numeric_limits<size_t>::digits; ++i, shift += 7)
+		{
+			value |= static_cast<size_t>(in[i] & 0x7F) << shift;
+			
+			if ((in[i] & 0x80) == 0)
+				return i + 1;
+		}
+		
+		return 0;
+	}
+	
+	// Upper bound of the size of the sparse form of any mask
+	static constexpr const size_t MAX_SPARSE_SIZE = get_varint_size(bit_length) + bit_length * get_varint_size(bit_length);
+	
+protected:
+	using Words = EnumeratorDataWords<DataType>;
+	using WordType = typename Words::WordType;
+#if defined(METAENUMERATOR_LITTLE_ENDIAN)
+	using FastPath = enumerator_is_plain_storage<DataType>;
+#else
+	using FastPath = std::false_type;
+#endif
+	
+public:
+	static void encode(const MaskType& mask, unsigned char* out)
+	{
+		encode(&mask, 1, out);
+	}
+	
+	static MaskType decode(const unsigned char* in)
+	{
+		MaskType mask;
+		decode(in, 1, &mask);
+		
+		return mask;
+	}
+	
+	// Writes count masks in packed form, out must hold count * PACKED_SIZE bytes
+	static void encode(const MaskType* masks, size_t count, unsigned char* out)
+	{
+		encodePacked(masks, count, out, FastPath{});
+	}
+	
+	// Reads count masks in packed form
+	static void decode(const unsigned char* in, size_t count, MaskType* masks)
+	{
+		decodePacked(in, count, masks, FastPath{});
+	}
+	
+	static size_t get_sparse_size(const MaskType& mask)
+	{
+		size_t size = get_varint_size(mask.count());
+		size_t previous = 0;
+		
+		for (auto index = mask.find_first(); index != 0; index = mask.find_next(index))
+		{
+			size += get_varint_size(index - previous - 1);
+			previous = index;
+		}
+		
+		return size;
+	}
+	
+	// Writes mask in sparse form and returns the amount of written bytes, out must hold get_sparse_size(mask) bytes
+	static size_t encode_sparse(const MaskType& mask, unsigned char* out)
+	{
+		size_t size = write_varint(mask.count(), out);
+		size_t previous = 0;
+		
+		for (auto index = mask.find_first(); index != 0; index = mask.find_next(index))
+		{
+			size += write_varint(index - previous - 1, out + size);
+			previous = index;
+		}
+		
+		return size;
+	}
+	
+	// Reads a mask in sparse form from at most size bytes, returns the amount of read bytes or 0 if the data is truncated or invalid
+	static size_t decode_sparse(const unsigned char* in, size_t size, MaskType& mask)
+	{
+		size_t count = 0;
+		size_t offset = read_varint(in, size, count);
+		
+		if (offset == 0 || count > bit_length)
+			return 0;
+		
+		DataType data{};
+		size_t position = 0;
+		size_t word_index = 0;
+		WordType word = 0;
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			size_t gap = 0;
+			auto read = read_varint(in + offset, size - offset, gap);
+			
+			if (read == 0 || gap >= bit_length - position)
+				return 0;
+			
+			offset += read;
+			position += gap;
+			
+			// Positions are ascending, so each word is complete once a position falls past it
+			if (position / Words::WORD_BITS != word_index)
+			{
+				if (word != 0)
+					Words::set_word(data, word_index, word);
+				
+				word_index = position / Words::WORD_BITS;
+				word = 0;
+			}
+			
+			word |= static_cast<WordType>(1) << (position % Words::WORD_BITS);
+			++position;
+		}
+		
+		if (word != 0)
+			Words::set_word(data, word_index, word);
+		
+		mask = MaskType(data);
+		return offset;
+	}
+	
+	// Writes count masks in sparse form one after the other, returns the amount of written bytes
+	static size_t encode_sparse(const MaskType* masks, size_t count, unsigned char* out)
+	{
+		size_t size = 0;
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			size += encode_sparse(masks[i], out + size);
+		}
+		
+		return size;
+	}
+	
+	// Reads count masks in sparse form from at most size bytes, returns the amount of read bytes or 0 if the data is truncated or invalid
+	static size_t decode_sparse(const unsigned char* in, size_t size, MaskType* masks, size_t count)
+	{
+		size_t offset = 0;
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto read = decode_sparse(in + offset, size - offset, masks[i]);
+			
+			if (read == 0)
+				return 0;
+			
+			offset += read;
+		}
+		
+		return offset;
+	}
+	
+protected:
+	// The in-memory layout is the packed form followed by padding, masks can be copied as they are
+	static void encodePacked(const MaskType* masks, size_t count, unsigned char* out, std::true_type)
+	{
+		if (PACKED_SIZE == sizeof(MaskType))
+		{
+			std::memcpy(out, masks, count * PACKED_SIZE);
+			return;
+		}
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			std::memcpy(out + i * PACKED_SIZE, &masks[i], PACKED_SIZE);
+		}
+	}
+	
+	static void decodePacked(const unsigned char* in, size_t count, MaskType* masks, std::true_type)
+	{
+		if (PACKED_SIZE == sizeof(MaskType))
+		{
+			std::memcpy(masks, in, count * PACKED_SIZE);
+			return;
+		}
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			DataType data{};
+			std::memcpy(&data, in + i * PACKED_SIZE, PACKED_SIZE);
+			masks[i] = MaskType(data);
+		}
+	}
+	
+	static void encodePacked(const MaskType* masks, size_t count, unsigned char* out, std::false_type)
+	{
+		for (size_t i = 0; i < count; ++i, out += PACKED_SIZE)
+		{
+			const DataType data = masks[i].data();
+			
+			for (size_t byte = 0; byte < PACKED_SIZE; ++byte)
+			{
+				const size_t bit = byte * CHAR_BIT;
+				out[byte] = static_cast<unsigned char>(Words::get_word(data, bit / Words::WORD_BITS) >> (bit % Words::WORD_BITS));
+			}
+		}
+	}
+	
+	static void decodePacked(const unsigned char* in, size_t count, MaskType* masks, std::false_type)
+	{
+		for (size_t i = 0; i < count; ++i, in += PACKED_SIZE)
+		{
+			DataType data{};
+			
+			for (size_t index = 0; index * Words::WORD_BITS < bit_length; ++index)
+			{
+				WordType word = 0;
+				
+				for (size_t bit = 0; bit < Words::WORD_BITS && index * Words::WORD_BITS + bit < PACKED_SIZE * CHAR_BIT; bit += CHAR_BIT)
+					word |= static_cast<WordType>(in[(index * Words::WORD_BITS + bit) / CHAR_BIT]) << bit;
+				
+				if (word != 0)
+					Words::set_word(data, index, word);
+			}
+			
+			masks[i] = MaskType(data);
+		}
+	}
+};
+
+// Read-only mask over memory holding its packed form (see EnumeratorMaskCodec), e.g. a record of a memory mapped file.
+// The memory is neither copied nor required to be aligned, and must outlive the view. Bits past bit_length are ignored
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskView
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	
+public:
+	using InnerType = EnumType;
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using DataType = typename MaskType::DataType;
+	using Codec = EnumeratorMaskCodec<EnumType, bit_length>;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	static constexpr const size_t SIZE = Codec::PACKED_SIZE;
+	
+protected:
+	using Words = EnumeratorDataWords<DataType>;
+	
+public:
+	using WordType = EnumeratorStorageWordType<DataType>;
+	static constexpr const size_t WORD_BITS = std::numeric_limits<WordType>::digits;
+	static constexpr const size_t WORD_COUNT = Words::WORD_COUNT;
+	
+public:
+	struct Iterator
 	{
 	public:
 		using iterator_category = std::input_iterator_tag;
@@ -1057,341 +5061,1040 @@ public:
 		using reference         = EnumType;
 		
 	public:
-		constexpr ReverseIterator(const EnumeratorMask* mask, size_t current = BIT_LENGTH) : _mask{mask}, _current{findValue(current)}
+		Iterator(const EnumeratorMaskView* view, size_t current) : _view{view}, _current{current}
 		{ }
 		
-		constexpr reference operator*() const { return Meta::MaskConverter::get_bit(_current); }
+		reference operator*() const { return Meta::MaskConverter::get_bit(_current); }
+		
+		Iterator& operator++() { _current = _view->find_next(_current); return *this; }
+		Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+		
+		friend bool operator== (const Iterator& a, const Iterator& b) { return a._view == b._view && a._current == b._current; }
+		friend bool operator!= (const Iterator& a, const Iterator& b) { return !(a == b); }
+		
+	private:
+		const EnumeratorMaskView* _view;
+		size_t _current;
+	};
+	
+public:
+	constexpr EnumeratorMaskView() noexcept : m_data{nullptr}
+	{	}
+	constexpr explicit EnumeratorMaskView(const void* data) noexcept : m_data{static_cast<const unsigned char*>(data)}
+	{	}
+	
+public:
+	constexpr const unsigned char* data() const
+	{
+		return m_data;
+	}
+	
+	// Copies the viewed bits into a mask
+	MaskType load() const
+	{
+		DataType data{};
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			auto word = get_word(i);
+			
+			if (word != 0)
+				Words::set_word(data, i, word);
+		}
+		
+		return MaskType(data);
+	}
+	
+	// Returns the index-th word of the mask, bit 0 of word 0 being the first value
+	WordType get_word(size_t index) const
+	{
+		const size_t offset = index * sizeof(WordType);
+		WordType word = 0;
+		
+#if defined(METAENUMERATOR_LITTLE_ENDIAN)
+		if (offset + sizeof(WordType) <= SIZE)
+		{
+			std::memcpy(&word, m_data + offset, sizeof(WordType));
+			return word & usedBits(index);
+		}
+#endif
+		
+		for (size_t byte = 0; byte < sizeof(WordType) && offset + byte < SIZE; ++byte)
+			word |= static_cast<WordType>(static_cast<WordType>(m_data[offset + byte]) << (byte * CHAR_BIT));
+		
+		return word & usedBits(index);
+	}
 	
-		constexpr ReverseIterator& operator++() { _current = findValue(_current - 1); return *this; }
-		constexpr ReverseIterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+	bool is_empty() const
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			if (get_word(i) != 0)
+				return false;
+		}
+		
+		return true;
+	}
 	
-		constexpr friend bool operator== (const ReverseIterator& a, const ReverseIterator& b) { return a._mask == b._mask && a._current == b._current; }
-		constexpr friend bool operator!= (const ReverseIterator& a, const ReverseIterator& b) { return !(a == b); }
+	bool has(EnumType bit) const
+	{
+		if (Meta::bitwise_conversion)
+		{
+			auto position = static_cast<size_t>(static_cast<typename std::make_unsigned<EnumType>::type>(bit));
+			
+			// Reads the single byte holding the value
+			if (position > 0 && position <= BIT_LENGTH)
+				return (m_data[(position - 1) / CHAR_BIT] >> ((position - 1) % CHAR_BIT)) & 1;
+		}
 		
-	protected:
-		constexpr size_t findValue(size_t current) const
+		return has(MaskType(bit));
+	}
+	
+	bool has(const MaskType& mask) const
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
 		{
-			while (!_mask->has_bit(current) && current > 0)
-			{
-				--current;
-			}
+			auto bits = static_cast<WordType>(Words::get_word(mask.data(), i));
 			
-			return current;
+			if (bits != 0 && (get_word(i) & bits) != bits)
+				return false;
 		}
 		
-	private:
-		const EnumeratorMask* _mask;
-		size_t _current;
-	};
+		return true;
+	}
 	
-	template <typename T = DataType, typename std::enable_if<std::is_scalar<T>::value, int>::type = 0>
-	static inline constexpr EnumeratorMask all()
+	bool has_any(const MaskType& mask) const
 	{
-		static_assert(sizeof(T) <= sizeof(DataType), "EnumeratorMask: T must fit inside DataType");
-		return EnumeratorMask(std::numeric_limits<T>::max());
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			auto bits = static_cast<WordType>(Words::get_word(mask.data(), i));
+			
+			if (bits != 0 && (get_word(i) & bits) != 0)
+				return true;
+		}
+		
+		return false;
 	}
 	
-	template <typename T = DataType, typename std::enable_if<!std::is_scalar<T>::value, int>::type = 0>
-	static inline constexpr EnumeratorMask all()
+	// Returns the amount of set bits
+	size_t count() const
 	{
-		static_assert(sizeof(T) <= sizeof(DataType), "EnumeratorMask: T must fit inside DataType");
-		return EnumeratorMask(T::max());
+		size_t total = 0;
+		
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			total += EnumeratorBits::popcount(get_word(i));
+		}
+		
+		return total;
 	}
 	
-public:
-	constexpr EnumeratorMask() noexcept : m_data{}
-	{	}
-	constexpr EnumeratorMask(const EnumeratorMask& other) noexcept = default;
-	constexpr EnumeratorMask(EnumType value) noexcept : m_data(Meta::MaskConverter::get_data(value)) 
+	// Returns the index of the first set bit, 0 if the mask is empty
+	size_t find_first() const
 	{
-		static_assert(
-			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
-			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
-		);
+		return find_next(0);
 	}
-	constexpr explicit EnumeratorMask(DataType data) noexcept : m_data(data)
-	{	}
 	
-public:
-	constexpr DataType data() const
+	// Returns the index of the first set bit after index, 0 if there is none
+	size_t find_next(size_t index) const
 	{
-		return m_data;
+		if (index >= BIT_LENGTH)
+			return 0;
+		
+		size_t word_index = index / WORD_BITS;
+		WordType word = get_word(word_index) & static_cast<WordType>(std::numeric_limits<WordType>::max() << (index % WORD_BITS));
+		
+		while (word == 0)
+		{
+			if (++word_index >= WORD_COUNT)
+				return 0;
+			
+			word = get_word(word_index);
+		}
+		
+		return word_index * WORD_BITS + EnumeratorBits::count_trailing_zeros(word) + 1;
 	}
 	
-	constexpr bool operator==(const EnumeratorMask& a) const
+	Iterator begin() const
 	{
-		return m_data == a.m_data;
+		return Iterator(this, find_first());
 	}
 	
-	constexpr bool operator==(EnumType a) const
+	Iterator end() const
 	{
-		return m_data == Meta::MaskConverter::get_data(a);
+		return Iterator(this, 0);
 	}
 	
-	constexpr bool operator!=(const EnumeratorMask& a) const
+	// Orders views as unsigned integers of bit_length bits, returns a negative value, 0 or a positive value
+	int compare(const EnumeratorMaskView& other) const
 	{
-		return m_data != a.m_data;
+		for (size_t i = WORD_COUNT; i-- > 0;)
+		{
+			auto a = get_word(i);
+			auto b = other.get_word(i);
+			
+			if (a != b)
+				return a < b ? -1 : 1;
+		}
+		
+		return 0;
 	}
 	
-	constexpr bool operator!=(EnumType a) const
+	bool operator==(const EnumeratorMaskView& other) const
 	{
-		return m_data != Meta::MaskConverter::get_data(a);
+		return compare(other) == 0;
 	}
 	
-	constexpr bool is_empty() const
+	bool operator!=(const EnumeratorMaskView& other) const
 	{
-		return m_data == 0;
+		return compare(other) != 0;
 	}
 	
-	constexpr bool has(EnumType bit) const
+	bool operator==(const MaskType& mask) const
 	{
-		static_assert(
-			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
-			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
-		);
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			if (get_word(i) != static_cast<WordType>(Words::get_word(mask.data(), i) & usedBits(i)))
+				return false;
+		}
 		
-		auto val = Meta::MaskConverter::get_data(bit);
-		return (m_data & val) == val;
+		return true;
 	}
 	
-	constexpr bool has(EnumeratorMask mask) const
+	bool operator!=(const MaskType& mask) const
 	{
-		return (m_data & mask.m_data) == mask.m_data;
+		return !(*this == mask);
 	}
 	
-	constexpr bool has(DataType data) const
+	friend bool operator==(const MaskType& mask, const EnumeratorMaskView& view)
 	{
-		return (m_data & data) == data;
+		return view == mask;
 	}
 	
-	constexpr bool has_any(EnumeratorMask mask) const
+	friend bool operator!=(const MaskType& mask, const EnumeratorMaskView& view)
 	{
-		return (m_data & mask.m_data) != 0;
+		return !(view == mask);
 	}
 	
-	constexpr bool has_any(DataType data) const
+protected:
+	static constexpr WordType usedBits(size_t index)
 	{
-		return (m_data & data) != 0;
+		return (index + 1) * WORD_BITS <= BIT_LENGTH ? std::numeric_limits<WordType>::max() : static_cast<WordType>(std::numeric_limits<WordType>::max() >> ((index + 1) * WORD_BITS - BIT_LENGTH));
 	}
 	
-	constexpr void set(EnumType bit, bool value)
+protected:
+	const unsigned char* m_data;
+};
+
+// Moves the bits of masks to other positions, e.g. to read masks stored before values were inserted or reordered in the enum.
+// The mapping is turned once into runs of consecutive bits moving together, which are then copied up to 64 bits at a time, so
+// the cost of a mask depends on its width and on how scattered the mapping is rather than on its amount of set bits
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskRemap
+{
+public:
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using Codec = EnumeratorMaskCodec<EnumType, bit_length>;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	static constexpr const size_t PACKED_SIZE = Codec::PACKED_SIZE;
+	
+protected:
+	using WordType = unsigned long long;
+	static constexpr const size_t WORD_BITS = std::numeric_limits<WordType>::digits;
+	static constexpr const size_t WORD_COUNT = (bit_length + WORD_BITS - 1) / WORD_BITS;
+	
+	struct Run
 	{
-		static_assert(
-			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
-			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
-		);
-		
-		auto val = Meta::MaskConverter::get_data(bit);
-		if (value)
-			m_data |= val;
-		else
-			m_data &= ~val;
-	}
+		size_t source;
+		size_t target;
+		size_t length;
+	};
 	
-	constexpr void set(EnumeratorMask mask, bool value)
+public:
+	// Keeps every bit in place
+	EnumeratorMaskRemap() : _runs{Run{0, 0, BIT_LENGTH}}
+	{	}
+	
+	// targets[i] is the new index of the value at index i + 1 (indices are 1-based as for find_first()), 0 drops it
+	explicit EnumeratorMaskRemap(const std::vector<size_t>& targets)
 	{
-		if (value)
-			m_data |= mask.m_data;
-		else
-			m_data &= ~mask.m_data;
+		for (size_t source = 0; source < BIT_LENGTH && source < targets.size(); ++source)
+		{
+			auto target = targets[source];
+			
+			if (target == 0 || target > BIT_LENGTH)
+				continue;
+			
+			if (!_runs.empty() && _runs.back().source + _runs.back().length == source && _runs.back().target + _runs.back().length == target - 1)
+				++_runs.back().length;
+			else
+				_runs.push_back(Run{source, target - 1, 1});
+		}
 	}
 	
-	constexpr void set(DataType data, bool value)
+public:
+	bool is_identity() const
 	{
-		if (value)
-			m_data |= data;
-		else
-			m_data &= ~data;
+		return _runs.size() == 1 && _runs[0].source == 0 && _runs[0].target == 0 && _runs[0].length == BIT_LENGTH;
 	}
 	
-	constexpr void clear()
+	// Returns the amount of runs of bits moving together, 1 for the identity
+	size_t get_run_count() const
 	{
-		m_data = 0;
+		return _runs.size();
 	}
-
-	constexpr EnumeratorMask operator|(EnumType a) const
+	
+	// Remaps count masks in packed form from in to out, which can be in itself
+	void remap(const unsigned char* in, size_t count, unsigned char* out) const
 	{
-		static_assert(
-			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
-			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
-		);
+		WordType source[WORD_COUNT];
+		WordType target[WORD_COUNT];
 		
-		auto data = Meta::MaskConverter::get_data(a);
-		EnumeratorMask m(m_data | data);
-		return m;
+		for (size_t i = 0; i < count; ++i, in += PACKED_SIZE, out += PACKED_SIZE)
+		{
+			loadWords(in, source);
+			apply(source, target);
+			storeWords(target, out);
+		}
 	}
 	
-	constexpr EnumeratorMask operator|(EnumeratorMask a) const
+	void remap(MaskType* masks, size_t count) const
 	{
-		EnumeratorMask m(m_data | a.m_data);
-		return m;
+		unsigned char packed[PACKED_SIZE];
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			Codec::encode(masks[i], packed);
+			remap(packed, 1, packed);
+			masks[i] = Codec::decode(packed);
+		}
 	}
 	
-	constexpr EnumeratorMask operator|=(EnumType a)
+	MaskType remap(const MaskType& mask) const
 	{
-		static_assert(
-			!Meta::bitwise_conversion || ((size_t)Meta::MAX_VALUE) <= bit_length,
-			"EnumeratorMask bit_length has to be large enough to contain enum MAX_VALUE"
-		);
+		MaskType result = mask;
+		remap(&result, 1);
 		
-		m_data = m_data | Meta::MaskConverter::get_data(a);
-		return *this;
-	}
-	
-	constexpr EnumeratorMask operator|=(EnumeratorMask a)
-	{ 
-		m_data = m_data | a.m_data;
-		return *this;
+		return result;
 	}
 	
-	constexpr EnumeratorMask operator&(EnumType a) const
-	{ 
-		EnumeratorMask m(m_data & Meta::MaskConverter::get_data(a));
-		return m;
+protected:
+	void apply(const WordType* source, WordType* target) const
+	{
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			target[i] = 0;
+		}
+		
+		for (auto&& run : _runs)
+		{
+			size_t from = run.source;
+			size_t to = run.target;
+			size_t length = run.length;
+			
+			while (length > 0)
+			{
+				// Takes as many bits as fit in the current target word
+				const size_t size = std::min(length, WORD_BITS - to % WORD_BITS);
+				const size_t offset = from % WORD_BITS;
+				WordType bits = source[from / WORD_BITS] >> offset;
+				
+				// Single word masks never straddle two words, the test also keeps the read below out of their builds
+				if (WORD_COUNT > 1 && offset + size > WORD_BITS)
+					bits |= source[from / WORD_BITS + 1] << (WORD_BITS - offset);
+				
+				if (size < WORD_BITS)
+					bits &= (static_cast<WordType>(1) << size) - 1;
+				
+				target[to / WORD_BITS] |= bits << (to % WORD_BITS);
+				from += size;
+				to += size;
+				length -= size;
+			}
+		}
 	}
 	
-	constexpr EnumeratorMask operator&(EnumeratorMask a) const
-	{ 
-		EnumeratorMask m(m_data & a.m_data);
-		return m;
+	static void loadWords(const unsigned char* in, WordType* words)
+	{
+#if defined(METAENUMERATOR_LITTLE_ENDIAN)
+		words[WORD_COUNT - 1] = 0;
+		std::memcpy(words, in, PACKED_SIZE);
+#else
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			words[i] = 0;
+		}
+		
+		for (size_t byte = 0; byte < PACKED_SIZE; ++byte)
+		{
+			words[byte / sizeof(WordType)] |= static_cast<WordType>(in[byte]) << (byte % sizeof(WordType) * CHAR_BIT);
+		}
+#endif
 	}
 	
-	constexpr EnumeratorMask operator&=(EnumType a)
-	{ 
-		m_data = m_data & Meta::MaskConverter::get_data(a);
-		return *this;
+	static void storeWords(const WordType* words, unsigned char* out)
+	{
+#if defined(METAENUMERATOR_LITTLE_ENDIAN)
+		std::memcpy(out, words, PACKED_SIZE);
+#else
+		for (size_t byte = 0; byte < PACKED_SIZE; ++byte)
+		{
+			out[byte] = static_cast<unsigned char>(words[byte / sizeof(WordType)] >> (byte % sizeof(WordType) * CHAR_BIT));
+		}
+#endif
 	}
 	
-	constexpr EnumeratorMask operator&=(EnumeratorMask a)
-	{ 
-		m_data = m_data & a.m_data;
-		return *this;
-	}
+protected:
+	std::vector<Run> _runs;
+};
+
+// Files holding a column of masks, made of:
+// - a header, which records bit_length, the amount of masks and the fingerprint of the enum, with a checksum of itself and of the name table
+// - the name table, one record per named value giving its bit index, followed by the null terminated names. It covers the own,
+//   inherited and extended values, so that masks can be remapped when read by a build in which values moved to other bits
+// - the body, starting at a page boundary: the masks in the packed form of EnumeratorMaskCodec, one after the other
+// The header and the name table use the native byte order, files are rejected by targets of the other byte order
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskFile
+{
+protected:
+	using Meta = EnumeratorMeta<EnumType>;
+	using Info = EnumeratorInfo<EnumType>;
 	
-	constexpr EnumeratorMask operator^(EnumType a) const
-	{ 
-		EnumeratorMask m(m_data ^ Meta::MaskConverter::get_data(a));
-		return m;
-	}
+public:
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using ViewType = EnumeratorMaskView<EnumType, bit_length>;
+	using Codec = EnumeratorMaskCodec<EnumType, bit_length>;
+	using RemapType = EnumeratorMaskRemap<EnumType, bit_length>;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	static constexpr const size_t PACKED_SIZE = Codec::PACKED_SIZE;
+	// Offset alignment of the body, a multiple of the page size of the common targets so that the masks can be mapped in place
+	static constexpr const size_t BODY_ALIGNMENT = 4096;
 	
-	constexpr EnumeratorMask operator^(EnumeratorMask a) const
-	{ 
-		EnumeratorMask m(m_data ^ a.m_data);
-		return m;
-	}
+protected:
+	static constexpr const uint32_t FILE_MAGIC = 0x434D454D; // "MEMC" when stored in little endian
+	static constexpr const uint32_t FILE_VERSION = 2;
 	
-	constexpr EnumeratorMask operator^=(EnumType a)
-	{ 
-		m_data = m_data ^ Meta::MaskConverter::get_data(a);
-		return *this;
-	}
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t bit_count;
+		uint64_t packed_size;
+		uint64_t entry_count;
+		uint64_t blob_size;
+		uint64_t mask_count;
+		uint64_t body_offset;
+		uint64_t fingerprint;
+		uint64_t checksum;
+	};
 	
-	constexpr EnumeratorMask operator^=(EnumeratorMask a)
-	{ 
-		m_data = m_data ^ a.m_data;
-		return *this;
-	}
+	struct FileRecord
+	{
+		uint64_t index;
+		uint32_t name_offset;
+		uint32_t name_length;
+	};
 	
-	constexpr EnumeratorMask operator~() const
-	{ 
-		EnumeratorMask m(~m_data);
-		return m;
-	}
+	struct FileName
+	{
+		size_t index;
+		const char* name;
+		size_t length;
+	};
 	
-	constexpr Iterator begin() const
+	// Adds the name of entry at the bit index (1-based) of its value, skipping values without a name or out of the mask
+	template <typename T>
+	static void addName(std::vector<FileName>& names, const typename EnumeratorInfo<T>::EntryType& entry)
 	{
-		return Iterator(this);
+		if (entry.get_name() == nullptr)
+			return;
+		
+		auto value = static_cast<EnumType>(static_cast<typename Meta::DataType>(entry.get_value()));
+		auto index = typename Meta::MaskType(value).find_first();
+		
+		if (index != 0 && index <= BIT_LENGTH)
+			names.push_back(FileName{index, entry.get_name(), EnumeratorInfo<T>::get_name_length(entry)});
 	}
 	
-	constexpr Iterator end() const
+	// Adds the names of the values registered at run time by the extensions of T and of the enums it inherits
+	template <typename T, typename std::enable_if<enumerator_inherits<T>::value, int>::type = 0>
+	static void addExtendedNames(std::vector<FileName>& names)
 	{
-		return Iterator(this, BIT_LENGTH);
+		addExtendedNamesSelf<T>(names);
+		addExtendedNames<typename EnumeratorInherited<T>::InheritedType>(names);
 	}
 	
-	constexpr Iterator cbegin() const
+	template <typename T, typename std::enable_if<!enumerator_inherits<T>::value, int>::type = 0>
+	static void addExtendedNames(std::vector<FileName>& names)
 	{
-		return Iterator(this);
+		addExtendedNamesSelf<T>(names);
 	}
 	
-	constexpr Iterator cend() const
+	template <typename T, typename std::enable_if<enumerator_has_extension<T>::value, int>::type = 0>
+	static void addExtendedNamesSelf(std::vector<FileName>& names)
 	{
-		return Iterator(this, BIT_LENGTH);
-	}
+		auto&& container = EnumeratorMeta<T>::Extender::get_container();
 		
-	constexpr ReverseIterator rbegin() const
-	{
-		return ReverseIterator(this);
+		for (size_t i = 0; i < container.get_size(); ++i)
+		{
+			auto entry = container.get_entry(i);
+			
+			if (entry != nullptr)
+				addName<T>(names, *entry);
+		}
 	}
 	
-	constexpr ReverseIterator rend() const
+	template <typename T, typename std::enable_if<!enumerator_has_extension<T>::value, int>::type = 0>
+	static void addExtendedNamesSelf(std::vector<FileName>&)
 	{
-		return ReverseIterator(this, 0);
 	}
 	
-	constexpr ReverseIterator crbegin() const
+	// Returns the names of the own, inherited and extended values sorted by bit index, keeping the first name of aliased values
+	static std::vector<FileName> getNames()
 	{
-		return ReverseIterator(this);
+		using List = EnumeratorEntryList<EnumType>;
+		std::vector<FileName> names;
+		
+		for (size_t i = 0; i < List::ENTRY_COUNT; ++i)
+		{
+			addName<EnumType>(names, *List::table.entries[i]);
+		}
+		
+		addExtendedNames<EnumType>(names);
+		
+		std::stable_sort(names.begin(), names.end(), [](const FileName& a, const FileName& b) { return a.index < b.index; });
+		names.erase(std::unique(names.begin(), names.end(), [](const FileName& a, const FileName& b) { return a.index == b.index; }), names.end());
+		return names;
 	}
 	
-	constexpr ReverseIterator crend() const
+	// The checksum covers the header, with checksum set to 0, and the name table
+	static unsigned long long getChecksum(FileHeader header, unsigned long long table_hash)
 	{
-		return ReverseIterator(this, 0);
+		header.checksum = 0;
+		return EnumeratorString::hash(reinterpret_cast<const char*>(&header), sizeof(header), table_hash);
 	}
 	
-	constexpr EnumType at(size_t index) const
+public:
+	// Writes masks as they come through a buffer of bounded size, then completes the header on close()
+	class Writer
 	{
-		auto data = m_data;
+	public:
+		Writer() = default;
+		Writer(const Writer&) = delete;
+		Writer& operator=(const Writer&) = delete;
+		
+		~Writer()
+		{
+			close();
+		}
+		
+	public:
+		// Creates path and writes the header and name table, buffer_size bounds the memory used to buffer masks
+		bool open(const char* path, size_t buffer_size = 1 << 16)
+		{
+			close();
+			
+			std::vector<char> table;
+			auto entry_count = buildTable(table);
+			
+			_file = std::fopen(path, "wb");
+			
+			if (_file == nullptr)
+				return false;
+			
+			auto table_size = table.size();
+			_header = FileHeader{FILE_MAGIC, FILE_VERSION, BIT_LENGTH, PACKED_SIZE, entry_count, table_size - entry_count * sizeof(FileRecord), 0, 0, EnumeratorFingerprint<EnumType>::VALUE, 0};
+			_header.body_offset = (sizeof(FileHeader) + table_size + BODY_ALIGNMENT - 1) / BODY_ALIGNMENT * BODY_ALIGNMENT;
+			_table_hash = EnumeratorString::hash(table.data(), table_size);
+			_header.checksum = getChecksum(_header, _table_hash);
+			
+			// The header is written again on close(), once the amount of masks is known
+			table.resize(_header.body_offset - sizeof(FileHeader), '\0');
+			_success = std::fwrite(&_header, sizeof(_header), 1, _file) == 1 && std::fwrite(table.data(), table.size(), 1, _file) == 1;
+			_buffer.resize(buffer_size > PACKED_SIZE ? buffer_size / PACKED_SIZE * PACKED_SIZE : PACKED_SIZE);
+			_buffered = 0;
+			
+			return _success;
+		}
+		
+		bool is_open() const
+		{
+			return _file != nullptr;
+		}
+		
+		// Returns the amount of masks written so far
+		size_t size() const
+		{
+			return static_cast<size_t>(_header.mask_count);
+		}
 		
-		while (data != 0)
+		bool push_back(const MaskType& mask)
 		{
-			auto value = data & 1;
+			return write(&mask, 1);
+		}
+		
+		bool write(const MaskType* masks, size_t count)
+		{
+			if (_file == nullptr || !_success)
+				return false;
 			
-			if (value)
+			const size_t capacity = _buffer.size() / PACKED_SIZE;
+			
+			while (count > 0)
 			{
-				if (index == 0)
-					return value;
+				auto amount = std::min(count, capacity - _buffered);
+				Codec::encode(masks, amount, _buffer.data() + _buffered * PACKED_SIZE);
+				
+				masks += amount;
+				count -= amount;
+				_buffered += amount;
+				_header.mask_count += amount;
 				
-				index--;
+				if (_buffered == capacity && !flush())
+					return false;
 			}
 			
-			data >> 1;
+			return true;
 		}
 		
-		return {};
+		// Writes the buffered masks and the final header, returns false if anything failed since open()
+		bool close()
+		{
+			if (_file == nullptr)
+				return false;
+			
+			if (_success && _buffered > 0)
+				flush();
+			
+			if (_success)
+			{
+				_header.checksum = getChecksum(_header, _table_hash);
+				_success = std::fseek(_file, 0, SEEK_SET) == 0 && std::fwrite(&_header, sizeof(_header), 1, _file) == 1;
+			}
+			
+			_success = std::fclose(_file) == 0 && _success;
+			_file = nullptr;
+			_buffer = std::vector<unsigned char>();
+			
+			return _success;
+		}
+		
+	protected:
+		bool flush()
+		{
+			_success = std::fwrite(_buffer.data(), _buffered * PACKED_SIZE, 1, _file) == 1;
+			_buffered = 0;
+			
+			return _success;
+		}
+		
+		// Fills table with the records and names of the values having one, returns the amount of records
+		static uint64_t buildTable(std::vector<char>& table)
+		{
+			std::vector<FileRecord> records;
+			std::vector<char> blob;
+			
+			for (auto&& name : getNames())
+			{
+				records.push_back(FileRecord{static_cast<uint64_t>(name.index), static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(name.length)});
+				blob.insert(blob.end(), name.name, name.name + name.length + 1);
+			}
+			
+			table.resize(records.size() * sizeof(FileRecord));
+			
+			if (!records.empty())
+				std::memcpy(table.data(), records.data(), table.size());
+			
+			table.insert(table.end(), blob.begin(), blob.end());
+			return records.size();
+		}
+		
+	protected:
+		std::FILE* _file = nullptr;
+		FileHeader _header{};
+		unsigned long long _table_hash = 0;
+		std::vector<unsigned char> _buffer;
+		size_t _buffered = 0;
+		bool _success = false;
+	};
+	
+	// Maps a file written by Writer and gives access to its masks in place. The file is checked once by open(), which also compares the
+	// stored names with the values of the enum: if some moved to other bits, the masks are remapped into memory owned by the reader,
+	// and the bits of names which don't exist anymore are dropped
+	class Reader
+	{
+	public:
+		Reader() = default;
+		Reader(const Reader&) = delete;
+		Reader& operator=(const Reader&) = delete;
+		
+		~Reader()
+		{
+			close();
+		}
+		
+	public:
+		bool open(const char* path)
+		{
+			close();
+			
+			size_t size = 0;
+			auto data = static_cast<const unsigned char*>(EnumeratorFile::map(path, size));
+			
+			if (data == nullptr)
+				return false;
+			
+			FileHeader header{};
+			
+			if (!validateFile(data, size, header))
+			{
+				EnumeratorFile::unmap(data, size);
+				return false;
+			}
+			
+			_data = data;
+			_size = size;
+			_body = data + header.body_offset;
+			_count = static_cast<size_t>(header.mask_count);
+			
+			// Same fingerprint, same bits, unless extensions registered their values in another order
+			if (header.fingerprint != EnumeratorFingerprint<EnumType>::VALUE || enumerator_is_extendable<EnumType>::value)
+			{
+				RemapType remap(buildTargets(reinterpret_cast<const char*>(data + sizeof(FileHeader)), header));
+				
+				if (!remap.is_identity())
+				{
+					_remapped.resize(_count * PACKED_SIZE);
+					remap.remap(_body, _count, _remapped.data());
+					_body = _remapped.data();
+				}
+			}
+			
+			return true;
+		}
+		
+		void close()
+		{
+			if (_data != nullptr)
+				EnumeratorFile::unmap(_data, _size);
+			
+			_data = _body = nullptr;
+			_size = _count = 0;
+			_remapped = std::vector<unsigned char>();
+		}
+		
+		bool is_open() const
+		{
+			return _data != nullptr;
+		}
+		
+		// Whether the masks had to be remapped when opening the file
+		bool is_remapped() const
+		{
+			return !_remapped.empty();
+		}
+		
+		size_t size() const
+		{
+			return _count;
+		}
+		
+		// Returns the packed masks, size() * PACKED_SIZE bytes starting at a page boundary when the file is memory mapped and not remapped
+		const unsigned char* data() const
+		{
+			return _body;
+		}
+		
+		ViewType operator[](size_t index) const
+		{
+			return ViewType(_body + index * PACKED_SIZE);
+		}
+		
+		// Decodes the masks from first to first + count into masks, returns the amount of decoded masks
+		size_t read(size_t first, size_t count, MaskType* masks) const
+		{
+			if (first >= _count)
+				return 0;
+			
+			count = std::min(count, _count - first);
+			Codec::decode(_body + first * PACKED_SIZE, count, masks);
+			
+			return count;
+		}
+		
+	protected:
+		static bool validateFile(const unsigned char* data, size_t size, FileHeader& header)
+		{
+			if (size < sizeof(FileHeader))
+				return false;
+			
+			std::memcpy(&header, data, sizeof(header));
+			
+			if (header.magic != FILE_MAGIC || header.version != FILE_VERSION || header.bit_count != BIT_LENGTH || header.packed_size != PACKED_SIZE)
+				return false;
+			
+			if (header.entry_count > BIT_LENGTH || header.body_offset % BODY_ALIGNMENT != 0 || header.body_offset > size)
+				return false;
+			
+			auto records_size = header.entry_count * sizeof(FileRecord);
+			
+			if (header.blob_size > header.body_offset || sizeof(FileHeader) + records_size > header.body_offset - header.blob_size)
+				return false;
+			
+			if (header.mask_count != (size - header.body_offset) / PACKED_SIZE || (size - header.body_offset) % PACKED_SIZE != 0)
+				return false;
+			
+			auto table = reinterpret_cast<const char*>(data + sizeof(FileHeader));
+			
+			if (header.checksum != getChecksum(header, EnumeratorString::hash(table, records_size + header.blob_size)))
+				return false;
+			
+			return validateTable(table, header);
+		}
+		
+		static bool validateTable(const char* table, const FileHeader& header)
+		{
+			for (size_t i = 0; i < header.entry_count; ++i)
+			{
+				FileRecord record;
+				std::memcpy(&record, table + i * sizeof(FileRecord), sizeof(record));
+				
+				if (record.index == 0 || record.index > BIT_LENGTH || static_cast<uint64_t>(record.name_offset) + record.name_length >= header.blob_size)
+					return false;
+			}
+			
+			return true;
+		}
+		
+		// Looks up the current index of each stored name, values without a name keep their index
+		static std::vector<size_t> buildTargets(const char* table, const FileHeader& header)
+		{
+			auto blob = table + header.entry_count * sizeof(FileRecord);
+			std::vector<size_t> targets(BIT_LENGTH);
+			
+			for (size_t i = 0; i < BIT_LENGTH; ++i)
+			{
+				targets[i] = i + 1;
+			}
+			
+			for (size_t i = 0; i < header.entry_count; ++i)
+			{
+				FileRecord record;
+				std::memcpy(&record, table + i * sizeof(FileRecord), sizeof(record));
+				
+				auto it = Info::find(blob + record.name_offset, record.name_length);
+				targets[record.index - 1] = it ? typename Meta::MaskType((*it).get_value()).find_first() : 0;
+			}
+			
+			return targets;
+		}
+		
+	protected:
+		const unsigned char* _data = nullptr;
+		size_t _size = 0;
+		const unsigned char* _body = nullptr;
+		size_t _count = 0;
+		std::vector<unsigned char> _remapped;
+	};
+};
+
+// Encodes the changes between two snapshots of the masks of entities, to replicate them by sending only what changed. A stream
+// starts with one bit per entity telling whether its mask changed, followed by the XOR of the old and new mask of each changed
+// entity, in whichever form is smaller:
+// - the sparse form of EnumeratorMaskCodec (amount of flipped bits then the gaps between them), which is never empty
+// - a 0 byte, then the amount of non-zero 64-bit words of the packed XOR and for each of them the gap from the previous one and its
+//   bytes (less for the last word when the mask is shorter), for masks where many bits flipped
+// All integers are unsigned LEB128 varints
+template <typename EnumType, size_t bit_length = std::numeric_limits<typename std::make_unsigned<EnumType>::type>::digits>
+class EnumeratorMaskDelta
+{
+public:
+	using MaskType = EnumeratorMask<EnumType, bit_length>;
+	using Codec = EnumeratorMaskCodec<EnumType, bit_length>;
+	static constexpr const size_t BIT_LENGTH = bit_length;
+	static constexpr const size_t PACKED_SIZE = Codec::PACKED_SIZE;
+	
+protected:
+	static constexpr const size_t CHUNK_SIZE = sizeof(unsigned long long);
+	static constexpr const size_t CHUNK_COUNT = (PACKED_SIZE + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	static constexpr const size_t MAX_CHUNKS_SIZE = 1 + Codec::get_varint_size(CHUNK_COUNT) + CHUNK_COUNT * Codec::get_varint_size(CHUNK_COUNT) + PACKED_SIZE;
+	
+public:
+	// Upper bound of the size of the change of a single mask
+	static constexpr const size_t MAX_ENTRY_SIZE = Codec::MAX_SPARSE_SIZE < MAX_CHUNKS_SIZE ? Codec::MAX_SPARSE_SIZE : MAX_CHUNKS_SIZE;
+	
+	// Upper bound of the size of the stream of count masks
+	static constexpr size_t get_max_size(size_t count)
+	{
+		return (count + CHAR_BIT - 1) / CHAR_BIT + count * MAX_ENTRY_SIZE;
 	}
 	
-	std::string toString() const
+	// Writes the changes from previous to current, count masks each, and returns the amount of written bytes. out must hold
+	// get_max_size(count) bytes
+	static size_t encode(const MaskType* previous, const MaskType* current, size_t count, unsigned char* out)
+	{
+		const size_t flags_size = (count + CHAR_BIT - 1) / CHAR_BIT;
+		size_t size = flags_size;
+		
+		std::memset(out, 0, flags_size);
+		
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (previous[i] == current[i])
+				continue;
+			
+			MaskType change(previous[i].data() ^ current[i].data());
+			
+			// Bits past bit_length, e.g. set by operator~, aren't part of the stream
+			if (change.find_first() == 0)
+				continue;
+			
+			out[i / CHAR_BIT] |= static_cast<unsigned char>(1 << (i % CHAR_BIT));
+			size += encodeEntry(change, out + size);
+		}
+		
+		return size;
+	}
+	
+	// Applies the changes read from at most size bytes to the count masks, returns the amount of read bytes or 0 if the data is truncated
+	// or invalid. On failure the masks before the faulty change have been updated already
+	static size_t decode(const unsigned char* in, size_t size, MaskType* masks, size_t count)
 	{
-		std::stringstream ss;
-		ss << *this;
+		const size_t flags_size = (count + CHAR_BIT - 1) / CHAR_BIT;
+		
+		if (size < flags_size)
+			return 0;
+		
+		size_t offset = flags_size;
+		
+		for (size_t byte = 0; byte < flags_size; ++byte)
+		{
+			// Walks the changed entities only, unchanged ones cost a bit of the flags
+			for (unsigned int flags = in[byte]; flags != 0; flags &= flags - 1)
+			{
+				const size_t i = byte * CHAR_BIT + EnumeratorBits::count_trailing_zeros(flags);
+				MaskType change;
+				
+				if (i >= count)
+					return 0;
+				
+				auto read = decodeEntry(in + offset, size - offset, change);
+				
+				if (read == 0)
+					return 0;
+				
+				masks[i] = MaskType(masks[i].data() ^ change.data());
+				offset += read;
+			}
+		}
 		
-		return ss.str();
+		return offset;
 	}
 	
 protected:
-	template<typename ValueType = DataType, typename std::enable_if<!std::is_same<ValueType, EnumeratorDataContainer<bit_length>>::value, int>::type = 0>
-	constexpr bool has_bit(size_t bit) const
+	static size_t encodeEntry(const MaskType& change, unsigned char* out)
 	{
-		if (bit == 0)
-			return false;
+		const size_t sparse_size = Codec::get_sparse_size(change);
+		
+		// The word form takes at least 3 bytes on top of the bytes of a word
+		if (sparse_size <= 3 + getChunkSize(0))
+			return Codec::encode_sparse(change, out);
 		
-		return m_data.has_bit(bit - 1);
+		unsigned char packed[PACKED_SIZE];
+		Codec::encode(change, packed);
+		
+		size_t chunk_count = 0;
+		size_t chunks_size = 1;
+		
+		for (size_t chunk = 0, previous = 0; chunk < CHUNK_COUNT; ++chunk)
+		{
+			if (isZero(packed, chunk))
+				continue;
+			
+			chunks_size += Codec::get_varint_size(chunk - previous) + getChunkSize(chunk);
+			previous = chunk;
+			++chunk_count;
+		}
+		
+		chunks_size += Codec::get_varint_size(chunk_count);
+		
+		if (sparse_size <= chunks_size)
+			return Codec::encode_sparse(change, out);
+		
+		size_t size = 0;
+		out[size++] = 0;
+		size += Codec::write_varint(chunk_count, out + size);
+		
+		for (size_t chunk = 0, previous = 0; chunk < CHUNK_COUNT; ++chunk)
+		{
+			if (isZero(packed, chunk))
+				continue;
+			
+			size += Codec::write_varint(chunk - previous, out + size);
+			std::memcpy(out + size, packed + chunk * CHUNK_SIZE, getChunkSize(chunk));
+			size += getChunkSize(chunk);
+			previous = chunk;
+		}
+		
+		return size;
 	}
-	template<typename ValueType = DataType, typename std::enable_if<std::is_same<ValueType, EnumeratorDataContainer<bit_length>>::value, int>::type = 0>
-	constexpr bool has_bit(size_t bit) const
+	
+	static size_t decodeEntry(const unsigned char* in, size_t size, MaskType& change)
 	{
-		if (bit == 0)
-			return false;
+		if (size == 0)
+			return 0;
 		
-		auto val = static_cast<DataType>(1) << (bit - 1);
-		return (m_data & val) == val;
+		if (in[0] != 0)
+			return Codec::decode_sparse(in, size, change);
+		
+		size_t chunk_count = 0;
+		size_t offset = 1 + Codec::read_varint(in + 1, size - 1, chunk_count);
+		
+		if (offset == 1 || chunk_count == 0 || chunk_count > CHUNK_COUNT)
+			return 0;
+		
+		unsigned char packed[PACKED_SIZE]{};
+		
+		for (size_t i = 0, chunk = 0; i < chunk_count; ++i)
+		{
+			size_t gap = 0;
+			auto read = Codec::read_varint(in + offset, size - offset, gap);
+			
+			// Gaps are 0 for the first word only, words are ascending
+			if (read == 0 || gap >= CHUNK_COUNT - chunk || (i > 0 && gap == 0))
+				return 0;
+			
+			chunk += gap;
+			offset += read;
+			
+			if (size - offset < getChunkSize(chunk))
+				return 0;
+			
+			std::memcpy(packed + chunk * CHUNK_SIZE, in + offset, getChunkSize(chunk));
+			offset += getChunkSize(chunk);
+		}
+		
+		change = Codec::decode(packed);
+		return offset;
 	}
 	
-protected:
-	DataType m_data;
+	static constexpr size_t getChunkSize(size_t chunk)
+	{
+		return PACKED_SIZE - chunk * CHUNK_SIZE < CHUNK_SIZE ? PACKED_SIZE - chunk * CHUNK_SIZE : CHUNK_SIZE;
+	}
+	
+	static bool isZero(const unsigned char* packed, size_t chunk)
+	{
+		unsigned long long word = 0;
+		std::memcpy(&word, packed + chunk * CHUNK_SIZE, getChunkSize(chunk));
+		
+		return word == 0;
+	}
 };
 
 
+
 template<typename EnumType, typename std::enable_if<std::is_enum<EnumType>::value && EnumeratorMeta<EnumType>::Specializer::has_base(), int>::type = 0>
 inline constexpr typename EnumeratorMeta<EnumType>::BaseEnumType operator+(EnumType value)
 {
@@ -1595,29 +6298,7 @@ inline std::ostream& operator<<(std::ostream& os, EnumType value)
 template <typename EnumType, size_t bit_length, typename std::enable_if<std::is_enum<EnumType>::value && EnumeratorMeta<EnumType>::string_operators, int>::type = 0>
 inline std::ostream& operator<<(std::ostream&os, const EnumeratorMask<EnumType, bit_length>& value)
 {
-	using Meta = EnumeratorMeta<EnumType>;
-	using Converter = typename Meta::MaskConverter;
-	auto data = value.data();
-	size_t index = 1;
-	
-	typename Meta::MaskDataType val = 0;
-	
-	while(data != 0)
-	{
-		if (val)
-			os << ", ";
-		
-		val = (data & 0x01);
-		
-		if (val)
-		{
-			EnumType v = Converter::get_bit(index);
-			os << v;
-		}
-		
-		data = data >> 1;
-		index++;
-	}
+	value.format_to(std::ostreambuf_iterator<char>(os));
 	
 	return os;
 }
@@ -1633,6 +6314,7 @@ public:
 	using Inheritor = EnumeratorInheritor<EnumType>;
 	using Specializer = EnumeratorSpecializer<EnumType>;
 	using MaskType = EnumeratorMask<EnumType, max_value>;
+	using AtomicMaskType = EnumeratorAtomicMask<EnumType, max_value>;
 	using MaskDataType = typename MaskType::DataType;
 	using MaskConverter = EnumeratorConverter<EnumType, MaskDataType, max_value, isFlags>;
 	static constexpr const bool bitwise_conversion = !isFlags;
@@ -1643,14 +6325,16 @@ public:
 		EnumType value{};
 		const char* name{};
 		const char* label{};
+		size_t name_length{};
 		
 		constexpr EnumEntry() = default;
-		constexpr EnumEntry(EnumType val, const char* name_) : value(val), name(name_), label("") { }
-		constexpr EnumEntry(EnumType val, const char* name_, const char* label_) : value(val), name(name_), label(label_) { }
+		constexpr EnumEntry(EnumType val, const char* name_) : value(val), name(name_), label(""), name_length(EnumeratorString::length(name_)) { }
+		constexpr EnumEntry(EnumType val, const char* name_, const char* label_) : value(val), name(name_), label(label_), name_length(EnumeratorString::length(name_)) { }
 		
 		constexpr EnumType get_value() const { return value; }
 		constexpr const char* get_name() const { return name; }
 		constexpr const char* get_label() const { return label; }
+		constexpr size_t get_name_length() const { return name_length; }
 	};
 };
 
@@ -38,6 +38,34 @@ public:
 
 constexpr EnumeratorMeta<TargetType>::EnumEntry EnumeratorMeta<TargetType>::enum_entries[];
 
+// Values which are already bit flags
+enum class Permission : unsigned int
+{
+	NONE = 0,
+	READ = 1 << 0,
+	WRITE = 1 << 1,
+	EXECUTE = 1 << 2,
+	ADMIN = 1u << 31
+};
+
+template <>
+class EnumeratorMeta<Permission> : public EnumeratorMetaDefault<Permission, true, 32>
+{
+public:
+	static constexpr const bool logic_operators = true;
+	static constexpr const bool string_operators = true;
+	static constexpr const Permission MAX_VALUE = Permission::ADMIN;
+	
+	static constexpr const EnumEntry enum_entries[]{
+		{ Permission::READ, "READ" },
+		{ Permission::WRITE, "WRITE" },
+		{ Permission::EXECUTE, "EXECUTE" },
+		{ Permission::ADMIN, "ADMIN" }
+	};
+};
+
+constexpr EnumeratorMeta<Permission>::EnumEntry EnumeratorMeta<Permission>::enum_entries[];
+
 }
 
 
@@ -67,5 +95,12 @@ int main(int argc, char *argv[])
 		// prints: We got this target: ALLY_CORPSE
 	}
 	
+	{
+		// masks of flag enums work the same way
+		auto permissions = Permission::READ | Permission::EXECUTE | Permission::ADMIN;
+		std::cout << "\nPermissions: " << permissions << ", second one: " << permissions.at(1);
+		// prints: Permissions: READ, EXECUTE, ADMIN, second one: EXECUTE
+	}
+	
 	std::cout << "\n";
 }
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#define METAENUMERATOR_NAMESPACE MyRootNamespace
+#include "MetaEnumerator.hpp"
+
+// Build with optimizations and the target ISA enabled to compare the SIMD code paths against the scalar fallback, e.g.:
+// g++ -std=c++14 -O2 -march=native -I.. benchmark.cpp -o benchmark
+
+
+namespace MyRootNamespace
+{
+
+enum class Flag
+{
+	NONE = 0,
+	FIRST,
+	MAX = 255
+};
+
+template <>
+class EnumeratorMeta<Flag> : public EnumeratorMetaDefault<Flag, false, 255>
+{
+public:
+	static constexpr const bool logic_operators = true;
+	static constexpr const Flag MAX_VALUE = Flag::MAX;
+	
+	static constexpr const EnumEntry enum_entries[]{
+		{ Flag::FIRST, "FIRST" }
+	};
+};
+
+constexpr EnumeratorMeta<Flag>::EnumEntry EnumeratorMeta<Flag>::enum_entries[];
+
+template <typename Function>
+double measure(Function&& function, size_t iterations)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < iterations; ++i)
+		function();
+
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+template <size_t BitLength, typename Operation>
+void benchmark_operation(const char* name, size_t iterations)
+{
+	using Container = EnumeratorDataContainer<BitLength>;
+	using Kernel = typename Container::Kernel;
+	constexpr size_t MASK_COUNT = 1024;
+
+	std::vector<Container> a(MASK_COUNT), b(MASK_COUNT), r(MASK_COUNT);
+
+	for (size_t i = 0; i < MASK_COUNT; ++i)
+	{
+		for (size_t j = 0; j < Container::OPERAND_COUNT; ++j)
+		{
+			a[i]._data[j] = static_cast<typename Container::OperandType>(std::rand());
+			b[i]._data[j] = static_cast<typename Container::OperandType>(std::rand());
+		}
+	}
+
+	size_t index = 0;
+
+	double scalar = measure([&]() {
+		Kernel::template transform_scalar<Operation>(r[index]._data, a[index]._data, b[index]._data);
+		index = (index + 1) % MASK_COUNT;
+	}, iterations);
+
+	double dispatched = measure([&]() {
+		Kernel::template transform<Operation>(r[index]._data, a[index]._data, b[index]._data);
+		index = (index + 1) % MASK_COUNT;
+	}, iterations);
+
+	std::cout << BitLength << " bits " << name << ": scalar " << scalar << " ns, dispatched " << dispatched << " ns, speedup " << (scalar / dispatched) << "x\n";
+}
+
+template <size_t BitLength>
+void benchmark_width(size_t iterations)
+{
+	benchmark_operation<BitLength, EnumeratorBitAnd>("and", iterations);
+	benchmark_operation<BitLength, EnumeratorBitOr>("or ", iterations);
+	benchmark_operation<BitLength, EnumeratorBitXor>("xor", iterations);
+	benchmark_operation<BitLength, EnumeratorBitNot>("not", iterations);
+}
+
+template <typename Container>
+size_t scan_container(const Container& a, const Container& b)
+{
+	using Bits = EnumeratorDataBits<Container>;
+	size_t total = static_cast<bool>(a & b) ? 1 : 0;
+	
+	for (auto bit = Bits::find_next(a, 0, 8192); bit != Bits::NOT_FOUND; bit = Bits::find_next(a, bit + 1, 8192))
+		total += bit;
+	
+	return total;
+}
+
+void benchmark_summary(size_t iterations)
+{
+	constexpr size_t MASK_COUNT = 64;
+	std::vector<EnumeratorDataContainer<8192>> dense_a(MASK_COUNT), dense_b(MASK_COUNT);
+	std::vector<EnumeratorSummaryContainer<8192>> summary_a, summary_b;
+	
+	for (size_t i = 0; i < MASK_COUNT; ++i)
+	{
+		dense_a[i] = dense_b[i] = EnumeratorDataContainer<8192>{};
+		
+		// A few values clustered at both ends of the masks
+		for (size_t j = 0; j < 4; ++j)
+		{
+			size_t bit_a = j < 2 ? std::rand() % 128 : 8064 + std::rand() % 128;
+			size_t bit_b = j < 2 ? 128 + std::rand() % 128 : 7936 + std::rand() % 128;
+			dense_a[i]._data[bit_a / 64] |= 1ULL << (bit_a % 64);
+			dense_b[i]._data[bit_b / 64] |= 1ULL << (bit_b % 64);
+		}
+		
+		summary_a.emplace_back(dense_a[i]);
+		summary_b.emplace_back(dense_b[i]);
+	}
+	
+	size_t index = 0, sink = 0;
+	
+	double dense = measure([&]() {
+		sink += scan_container(dense_a[index], dense_b[index]);
+		index = (index + 1) % MASK_COUNT;
+	}, iterations / 10);
+	
+	double summary = measure([&]() {
+		sink += scan_container(summary_a[index], summary_b[index]);
+		index = (index + 1) % MASK_COUNT;
+	}, iterations / 10);
+	
+	std::cout << "8192 bits intersect and iterate: dense " << dense << " ns, summary " << summary << " ns, speedup " << (dense / summary) << "x (" << sink % 2 << ")\n";
+}
+
+void benchmark_filter(size_t iterations)
+{
+	using Mask = EnumeratorMask<Flag, 255>;
+	constexpr size_t MASK_COUNT = 1 << 20;
+	
+	std::vector<Mask> masks(MASK_COUNT);
+	EnumeratorMaskArray<Flag, 255> array;
+	array.reserve(MASK_COUNT);
+	
+	for (size_t i = 0; i < MASK_COUNT; ++i)
+	{
+		for (size_t j = 0; j < 8; ++j)
+			masks[i] |= static_cast<Flag>(1 + std::rand() % 255);
+		
+		array.push_back(masks[i]);
+	}
+	
+	Mask required = static_cast<Flag>(3) | static_cast<Flag>(70);
+	Mask forbidden = static_cast<Flag>(5) | static_cast<Flag>(200);
+	std::vector<uint32_t> selection;
+	selection.reserve(MASK_COUNT);
+	size_t passes = iterations / MASK_COUNT + 1;
+	
+	double scalar = measure([&]() {
+		selection.clear();
+		
+		for (size_t i = 0; i < MASK_COUNT; ++i)
+		{
+			if (masks[i].has(required) && !masks[i].has_any(forbidden))
+				selection.push_back(static_cast<uint32_t>(i));
+		}
+	}, passes);
+	
+	double columnar = measure([&]() {
+		selection.clear();
+		array.filter_has_none(required, forbidden, selection);
+	}, passes);
+	
+	double parallel = measure([&]() {
+		selection.clear();
+		EnumeratorMaskScan<Flag, 255>::filter_has_none(masks.data(), masks.size(), required, forbidden, selection);
+	}, passes);
+	
+	std::cout << MASK_COUNT << " masks filter: scalar " << (scalar / MASK_COUNT) << " ns/mask, columnar " << (columnar / MASK_COUNT) << " ns/mask, speedup " << (scalar / columnar) << "x\n";
+	std::cout << MASK_COUNT << " masks filter: parallel " << (parallel / MASK_COUNT) << " ns/mask on " << EnumeratorThreadExecutor().get_concurrency() << " threads, speedup " << (scalar / parallel) << "x\n";
+}
+
+void benchmark_codec(size_t iterations)
+{
+	using Mask = EnumeratorMask<Flag, 255>;
+	using Codec = EnumeratorMaskCodec<Flag, 255>;
+	constexpr size_t MASK_COUNT = 1 << 20;
+	
+	std::vector<Mask> masks(MASK_COUNT), decoded(MASK_COUNT);
+	
+	for (size_t i = 0; i < MASK_COUNT; ++i)
+	{
+		for (size_t j = 0; j < 8; ++j)
+			masks[i] |= static_cast<Flag>(1 + std::rand() % 255);
+	}
+	
+	std::vector<unsigned char> packed(MASK_COUNT * Codec::PACKED_SIZE), sparse(MASK_COUNT * Codec::MAX_SPARSE_SIZE);
+	size_t passes = iterations / MASK_COUNT + 1, sparse_size = 0;
+	
+	double encode = measure([&]() {
+		Codec::encode(masks.data(), MASK_COUNT, packed.data());
+	}, passes);
+	
+	double decode = measure([&]() {
+		Codec::decode(packed.data(), MASK_COUNT, decoded.data());
+	}, passes);
+	
+	double encode_sparse = measure([&]() {
+		sparse_size = Codec::encode_sparse(masks.data(), MASK_COUNT, sparse.data());
+	}, passes);
+	
+	double decode_sparse = measure([&]() {
+		Codec::decode_sparse(sparse.data(), sparse_size, decoded.data(), MASK_COUNT);
+	}, passes);
+	
+	std::cout << MASK_COUNT << " masks packed: encode " << (encode / MASK_COUNT) << " ns/mask, decode " << (decode / MASK_COUNT) << " ns/mask, " << Codec::PACKED_SIZE << " bytes/mask\n";
+	std::cout << MASK_COUNT << " masks sparse: encode " << (encode_sparse / MASK_COUNT) << " ns/mask, decode " << (decode_sparse / MASK_COUNT) << " ns/mask, " << (static_cast<double>(sparse_size) / MASK_COUNT) << " bytes/mask\n";
+}
+
+void benchmark_remap(size_t iterations)
+{
+	using Mask = EnumeratorMask<Flag, 255>;
+	using Codec = EnumeratorMaskCodec<Flag, 255>;
+	constexpr size_t MASK_COUNT = 1 << 20;
+	
+	std::vector<Mask> masks(MASK_COUNT), remapped(MASK_COUNT);
+	
+	for (size_t i = 0; i < MASK_COUNT; ++i)
+	{
+		for (size_t j = 0; j < 8; ++j)
+			masks[i] |= static_cast<Flag>(1 + std::rand() % 255);
+	}
+	
+	// A value inserted at 100 shifts the following ones by one bit, the last one is dropped
+	std::vector<size_t> targets(255);
+	
+	for (size_t i = 0; i < targets.size(); ++i)
+		targets[i] = i < 99 ? i + 1 : (i + 2 <= 255 ? i + 2 : 0);
+	
+	EnumeratorMaskRemap<Flag, 255> remap(targets);
+	std::vector<unsigned char> packed(MASK_COUNT * Codec::PACKED_SIZE), packed_remapped(packed.size());
+	Codec::encode(masks.data(), MASK_COUNT, packed.data());
+	size_t passes = iterations / MASK_COUNT + 1;
+	
+	double per_bit = measure([&]() {
+		for (size_t i = 0; i < MASK_COUNT; ++i)
+		{
+			Mask result;
+			
+			for (auto index = masks[i].find_first(); index != 0; index = masks[i].find_next(index))
+			{
+				if (targets[index - 1] != 0)
+					result |= static_cast<Flag>(targets[index - 1]);
+			}
+			
+			remapped[i] = result;
+		}
+	}, passes);
+	
+	double runs = measure([&]() {
+		remap.remap(packed.data(), MASK_COUNT, packed_remapped.data());
+	}, passes);
+	
+	std::cout << MASK_COUNT << " masks remap: per bit " << (per_bit / MASK_COUNT) << " ns/mask, runs " << (runs / MASK_COUNT) << " ns/mask, speedup " << (per_bit / runs) << "x\n";
+}
+
+}
+
+
+int main(int argc, char *argv[])
+{
+	using namespace MyRootNamespace;
+
+	size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+
+	benchmark_width<255>(iterations);
+	benchmark_width<512>(iterations);
+	benchmark_width<1024>(iterations);
+	benchmark_summary(iterations);
+	benchmark_filter(iterations);
+	benchmark_codec(iterations);
+	benchmark_remap(iterations);
+
+	std::cout << "\n";
+}